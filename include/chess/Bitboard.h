@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chess/Loc.h>
+
+#include <cstdint>
+#include <iterator>
+
+namespace chess
+{
+    /**
+     * A set of squares, one bit per square. Bit N corresponds to the Loc with index N, so A1 is the least significant
+     * bit and H8 the most significant.
+     */
+    using Bitboard = std::uint64_t;
+
+    constexpr Bitboard bit(Loc loc)
+    {
+        return Bitboard{1} << static_cast<unsigned>(loc.index());
+    }
+
+    constexpr bool contains(Bitboard bb, Loc loc)
+    {
+        return (bb & bit(loc)) != 0;
+    }
+
+    constexpr int popcount(Bitboard bb)
+    {
+        return __builtin_popcountll(bb);
+    }
+
+    /**
+     * Location of the lowest set bit. The bitboard must not be empty.
+     */
+    constexpr Loc lsb(Bitboard bb)
+    {
+        return Loc{__builtin_ctzll(bb)};
+    }
+
+    /**
+     * Remove the lowest set bit and return its location. The bitboard must not be empty.
+     */
+    constexpr Loc pop_lsb(Bitboard & bb)
+    {
+        auto loc = lsb(bb);
+        bb &= bb - 1;
+        return loc;
+    }
+
+    /**
+     * Allows iterating over the locations in a bitboard with a range-for, lowest index first.
+     */
+    struct BitboardRange
+    {
+        struct iterator
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Loc;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Loc const*;
+            using reference = Loc;
+
+            constexpr Loc operator*() const { return lsb(m_remaining); }
+            constexpr iterator & operator++() { m_remaining &= m_remaining - 1; return *this; }
+            constexpr bool operator==(iterator other) const { return m_remaining == other.m_remaining; }
+            constexpr bool operator!=(iterator other) const { return m_remaining != other.m_remaining; }
+
+            Bitboard m_remaining;
+        };
+
+        constexpr iterator begin() const { return {m_bb}; }
+        constexpr iterator end() const { return {0}; }
+
+        Bitboard m_bb;
+    };
+
+    constexpr BitboardRange locs_of(Bitboard bb)
+    {
+        return {bb};
+    }
+}
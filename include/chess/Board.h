@@ -5,31 +5,175 @@
 
 #include <chess/Square.h>
 #include <chess/Loc.h>
+#include <chess/Bitboard.h>
+#include <chess/Ply.h>
+#include <chess/zobrist.h>
 
 namespace chess
 {
     struct Move;
 
+    /**
+     * The squares of a board, plus bitboards of where each piece type and colour is. The bitboards are kept in sync
+     * with the squares on every write, so the mutable operator[] hands out a SquareRef rather than a raw Square&.
+     */
     struct Board
     {
+        struct SquareRef;
+
         static Board standard();
         static Board blank();
         static Board with_pieces(std::vector<std::pair<Loc, Square>> const&);
 
-        constexpr Square & operator[](Loc loc)
+        constexpr SquareRef operator[](Loc loc);
+
+        constexpr Square const& operator[](Loc loc) const
         {
             return squares[loc.index()];
         }
 
-        constexpr Square const& operator[](Loc loc) const
+        /**
+         * Place a square on the board, updating the bitboards.
+         */
+        constexpr void set(Loc loc, Square sq)
         {
-            return squares[loc.index()];
+            auto const mask = bit(loc);
+            auto const old = squares[loc.index()];
+
+            if (old.type() != SquareType::empty)
+            {
+                m_types[static_cast<int>(old.type())] &= ~mask;
+                m_colours[static_cast<int>(old.colour())] &= ~mask;
+                m_piece_key ^= zobrist::piece(old, loc);
+            }
+
+            squares[loc.index()] = sq;
+
+            if (sq.type() != SquareType::empty)
+            {
+                m_types[static_cast<int>(sq.type())] |= mask;
+                m_colours[static_cast<int>(sq.colour())] |= mask;
+                m_piece_key ^= zobrist::piece(sq, loc);
+            }
+        }
+
+        /**
+         * Play the ply on this board, including flipping whose turn it is. The ply is assumed to be valid.
+         */
+        Undo make(Ply);
+
+        /**
+         * Take back a ply previously played with make, given what make returned.
+         */
+        void unmake(Ply, Undo const&);
+
+        constexpr Bitboard occupied() const
+        {
+            return m_colours[0] | m_colours[1];
+        }
+
+        constexpr Bitboard pieces(Colour colour) const
+        {
+            return m_colours[static_cast<int>(colour)];
+        }
+
+        constexpr Bitboard pieces(SquareType type) const
+        {
+            return m_types[static_cast<int>(type)];
+        }
+
+        constexpr Bitboard pieces(Colour colour, SquareType type) const
+        {
+            return pieces(colour) & pieces(type);
+        }
+
+        /**
+         * Where the given side's king is, if they have one. Boards set up for tests and puzzles may not.
+         */
+        constexpr std::optional<Loc> king(Colour colour) const
+        {
+            auto const kings = pieces(colour, SquareType::king);
+            if (kings)
+            {
+                return lsb(kings);
+            }
+            return std::nullopt;
         }
 
+        /**
+         * Zobrist hash of the position: the pieces, whose turn it is, castling rights and whether en passant is
+         * possible. Equal positions reached by different move orders hash the same.
+         *
+         * The piece part is kept up to date on every set. The rest is folded in here, since turn and
+         * last_turn_pawn_double_jump_dest can be assigned directly and castling rights follow from has_moved flags.
+         */
+        ZobristKey hash() const;
+
+        /**
+         * Boards are equal if every square matches, has_moved flags included since they decide castling, and so do
+         * the turn and the last double jump.
+         */
+        friend bool operator==(Board const&, Board const&);
+        friend bool operator!=(Board const&, Board const&);
+
         Colour turn = Colour::white;
         std::optional<Loc> last_turn_pawn_double_jump_dest = std::nullopt;
     private:
         Board() = default;
+
+        /**
+         * Recompute the bitboards and piece hash from the squares, for filling a board without going through set.
+         */
+        void rebuild();
+
         std::array<Square, Loc::board_size> squares = {};
+        std::array<Bitboard, 7> m_types = {};
+        std::array<Bitboard, 2> m_colours = {};
+        ZobristKey m_piece_key = 0;
+    };
+
+    bool operator==(Board const& lhs, Board const& rhs);
+    bool operator!=(Board const& lhs, Board const& rhs);
+
+    /**
+     * Mutable access to a single square of a board. Reads behave like a Square, writes go through Board::set.
+     */
+    struct Board::SquareRef
+    {
+        constexpr SquareRef(Board & board, Loc loc) : m_board{board}, m_loc{loc} {}
+
+        constexpr SquareRef & operator=(Square sq)
+        {
+            m_board.set(m_loc, sq);
+            return *this;
+        }
+
+        constexpr SquareRef & operator=(SquareRef const& other)
+        {
+            return *this = static_cast<Square>(other);
+        }
+
+        constexpr operator Square() const { return m_board.squares[m_loc.index()]; }
+
+        constexpr bool has_moved() const { return static_cast<Square>(*this).has_moved(); }
+        constexpr void set_moved() { m_board.squares[m_loc.index()].set_moved(); }
+        constexpr Colour colour() const { return static_cast<Square>(*this).colour(); }
+        constexpr SquareType type() const { return static_cast<Square>(*this).type(); }
+
+        constexpr void set_type(SquareType type)
+        {
+            auto sq = static_cast<Square>(*this);
+            sq.set_type(type);
+            m_board.set(m_loc, sq);
+        }
+
+    private:
+        Board & m_board;
+        Loc m_loc;
     };
-}
\ No newline at end of file
+
+    constexpr Board::SquareRef Board::operator[](Loc loc)
+    {
+        return {*this, loc};
+    }
+}
@@ -11,7 +11,12 @@ namespace chess
         normal,
         check,
         checkmate,
-        stalemate
+        stalemate,
+
+        /**
+         * Check and checkmate have not been worked out yet, see classify.
+         */
+        unclassified
     };
 
     struct Move
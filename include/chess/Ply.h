@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chess/Loc.h>
+#include <chess/Square.h>
+
+#include <cstdint>
+
+namespace chess
+{
+    enum class PlyKind : std::uint8_t
+    {
+        normal,
+        pawn_double_jump,
+        en_passant,
+        castling,
+        promotion,
+    };
+
+    /**
+     * A move described by what it changes rather than by the board it results in. Apply it with Board::make.
+     *
+     * For castling src and dest are the king's squares, the rook's squares follow from them. For en passant dest is
+     * where the capturing pawn lands, the captured pawn is beside src.
+     *
+     * Packed into 16 bits so move lists, search stacks and stored games stay small: 6 bits each for src and dest and
+     * 4 bits saying what kind of move it is, with the four promotions getting a code each.
+     */
+    struct Ply
+    {
+        constexpr Ply(Loc src, Loc dest, PlyKind kind = PlyKind::normal, SquareType promotion = SquareType::empty) :
+                m_data{static_cast<std::uint16_t>(src.index()
+                        | (dest.index() << dest_shift)
+                        | (encode_code(kind, promotion) << code_shift))}
+        {}
+
+        constexpr Loc src() const { return Loc{m_data & loc_mask}; }
+        constexpr Loc dest() const { return Loc{(m_data >> dest_shift) & loc_mask}; }
+
+        constexpr PlyKind kind() const
+        {
+            auto code = this->code();
+            return code >= promotion_code ? PlyKind::promotion : static_cast<PlyKind>(code);
+        }
+
+        /**
+         * The piece a pawn becomes, or empty if this is not a promotion.
+         */
+        constexpr SquareType promotion() const
+        {
+            auto code = this->code();
+            return code >= promotion_code
+                    ? static_cast<SquareType>(code - promotion_code + first_promotion_type)
+                    : SquareType::empty;
+        }
+
+        /**
+         * The packed form, for storing a ply outside of the library.
+         */
+        constexpr std::uint16_t raw() const { return m_data; }
+
+        static constexpr Ply from_raw(std::uint16_t raw)
+        {
+            auto ply = Ply{0, 0};
+            ply.m_data = raw;
+            return ply;
+        }
+
+    private:
+        static constexpr int dest_shift = 6;
+        static constexpr int code_shift = 12;
+        static constexpr int loc_mask = 0b11'1111;
+
+        // Each promotion gets its own code from PlyKind::promotion upwards, in SquareType order rook to queen.
+        static constexpr int promotion_code = static_cast<int>(PlyKind::promotion);
+        static constexpr int first_promotion_type = static_cast<int>(SquareType::rook);
+
+        static constexpr int encode_code(PlyKind kind, SquareType promotion)
+        {
+            return kind == PlyKind::promotion
+                    ? promotion_code + static_cast<int>(promotion) - first_promotion_type
+                    : static_cast<int>(kind);
+        }
+
+        constexpr int code() const { return m_data >> code_shift; }
+
+        std::uint16_t m_data;
+
+        friend constexpr bool operator==(Ply, Ply);
+        friend constexpr bool operator!=(Ply, Ply);
+    };
+
+    static_assert(sizeof(Ply) == 2);
+
+    constexpr bool operator==(Ply lhs, Ply rhs)
+    {
+        return lhs.m_data == rhs.m_data;
+    }
+
+    constexpr bool operator!=(Ply lhs, Ply rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * What Board::make overwrote, so that Board::unmake can put it back.
+     */
+    struct Undo
+    {
+        Square moved;
+        Square captured;
+        std::optional<Loc> last_turn_pawn_double_jump_dest;
+    };
+}
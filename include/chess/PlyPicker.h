@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chess/Board.h>
+#include <chess/Ply.h>
+#include <chess/available_moves.h>
+
+#include <array>
+#include <optional>
+
+namespace chess
+{
+    /**
+     * Whether the ply is quiet: not a capture, en passant or promotion.
+     */
+    bool is_quiet(Board const&, Ply);
+
+    /**
+     * Butterfly history: how much each quiet ply, by side, source and destination, has caused cutoffs anywhere in the
+     * search. Plies that were good in one position tend to be good in similar ones, so quiet plies are tried in order
+     * of their history.
+     */
+    class History
+    {
+    public:
+        /**
+         * Credit a quiet ply for a cutoff. Deeper cutoffs save more work, so count for more.
+         */
+        void reward(Colour, Ply, int depth);
+
+        int score(Colour, Ply) const;
+
+        void clear();
+
+    private:
+        using Table = std::array<std::array<int, Loc::board_size>, Loc::board_size>;
+        std::array<Table, 2> m_table = {};
+    };
+
+    /**
+     * Hands out the legal plies of a position one at a time, likeliest best first: the hash ply, then the captures
+     * and promotions that do not lose material, then killers, then the remaining quiet plies, and last the captures
+     * that lose material. Each stage is only generated once the one before it runs out, so a search that cuts off on
+     * an early ply never pays for generating the quiet ones.
+     *
+     * Captures are tried most valuable victim first, cheapest attacker breaking ties (MVV-LVA). One that takes a
+     * cheaper piece than it risks is checked with static exchange evaluation and held back if it loses. Quiet plies
+     * are tried by their history, if given one.
+     *
+     * Every legal ply is given exactly once. The hash ply and killers are checked for legality on this board first,
+     * since they come from other positions.
+     */
+    struct PlyPicker
+    {
+        /**
+         * Quiet plies that caused a cutoff in sibling positions, worth trying before other quiet plies.
+         */
+        using Killers = std::array<std::optional<Ply>, 2>;
+
+        /**
+         * The board, and the history if given, must outlive the picker and not change while it is in use.
+         */
+        explicit PlyPicker(Board const&, std::optional<Ply> hash_ply = std::nullopt, Killers killers = {},
+                           History const * history = nullptr);
+
+        /**
+         * The next ply to try, or nothing once every legal ply has been given.
+         */
+        std::optional<Ply> next();
+
+    private:
+        enum class Stage
+        {
+            hash,
+            generate_captures,
+            captures,
+            killers,
+            generate_quiets,
+            quiets,
+            losing_captures,
+            done,
+        };
+
+        /**
+         * Already given by an earlier stage, so must be skipped by a later one.
+         */
+        bool already_given(Ply) const;
+
+        /**
+         * Order the captures by MVV-LVA, moving any that lose material into m_losing_captures.
+         */
+        void order_captures();
+
+        Board const& m_board;
+        std::optional<Ply> m_hash_ply;
+        Killers m_killers;
+        History const * m_history;
+        Stage m_stage = Stage::hash;
+        MoveList m_plies;
+        MoveList m_losing_captures;
+        std::size_t m_index = 0;
+    };
+}
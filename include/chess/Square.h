@@ -46,11 +46,16 @@ namespace chess
 
         constexpr SquareType type() const { return static_cast<SquareType>(m_data & type_mask); }
         constexpr void set_type(SquareType type) { m_data &= ~type_mask; m_data |= static_cast<std::byte>(type); }
-    private:
+
+        /**
+         * The packed byte and its fields, for code that scans a whole board of squares at once.
+         */
+        constexpr std::byte bits() const { return m_data; }
+
         static std::byte constexpr type_mask   {0b0000'0111};
         static std::byte constexpr colour_mask {0b1000'0000};
         static std::byte constexpr move_mask   {0b0100'0000};
-
+    private:
         std::byte m_data;
 
         friend constexpr bool operator==(Square const&, Square const&);
@@ -2,9 +2,13 @@
 
 #include <chess/Board.h>
 #include <chess/Move.h>
-#include <chess/Tree.h>
+#include <chess/Ply.h>
+#include <chess/TranspositionTable.h>
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <optional>
 
 namespace chess
 {
@@ -12,25 +16,76 @@ namespace chess
     using EvalFunc = std::function<Score(Move const&)>;
     struct Move;
 
+    /**
+     * When to stop searching. The search deepens one ply at a time until the depth is reached or the time or node
+     * budget runs out, whichever comes first.
+     */
+    struct SearchLimits
+    {
+        static constexpr int default_depth = 4;
+
+        int depth = default_depth;
+
+        /**
+         * Wall time for the whole search, measured from the start of suggest.
+         */
+        std::optional<std::chrono::milliseconds> time = std::nullopt;
+
+        /**
+         * Positions visited over the whole search, every iteration included.
+         */
+        std::optional<std::uint64_t> nodes = std::nullopt;
+    };
+
+    struct SearchResult
+    {
+        /**
+         * The best move of the deepest iteration that finished, or an invalid move if there are none.
+         */
+        Move move;
+
+        /**
+         * The depth of the iteration the move came from.
+         */
+        int depth = 0;
+
+        std::uint64_t nodes = 0;
+    };
+
     struct Suggester
     {
-        Suggester(Board, EvalFunc);
+        static constexpr int default_depth = SearchLimits::default_depth;
+
+        /**
+         * The evaluation scores the move into a leaf of the search, positive when white is ahead.
+         */
+        Suggester(Board, EvalFunc, int depth = default_depth);
+        Suggester(Board, EvalFunc, SearchLimits);
 
+        /**
+         * Search with a transposition table, which must outlive the suggester. The table can be kept between moves of
+         * a game and shared with other searches. Stored scores are only valid for one evaluation function, and assume
+         * it only looks at the position a move results in.
+         */
+        Suggester(Board, EvalFunc, SearchLimits, TranspositionTable &);
+
+        /**
+         * Search by iterative deepening within the limits. An iteration stopped part way through is thrown away,
+         * except that the first always finishes so that there is a move to return.
+         */
+        SearchResult search() const;
+
+        /**
+         * The move from search.
+         */
         Move suggest() const;
 
     private:
-        struct Evaluation
-        {
-            Score score;
-            Move move;
-        };
-
         Board m_current;
         EvalFunc m_eval;
-        Tree<Evaluation> m_tree;
-
-        void build_tree(Tree<Evaluation> & root, int depth);
+        SearchLimits m_limits;
+        TranspositionTable * m_table = nullptr;
     };
 
     Score evaluate_with_summation(Move const&);
-}
\ No newline at end of file
+}
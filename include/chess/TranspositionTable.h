@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chess/Ply.h>
+#include <chess/zobrist.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace chess
+{
+    /**
+     * How a stored score relates to the position's true score, which depends on the window it was searched with.
+     */
+    enum class Bound : std::uint8_t
+    {
+        none,
+        exact,
+
+        /**
+         * The search cut off, so the true score is at least this.
+         */
+        lower,
+
+        /**
+         * Nothing beat the window, so the true score is at most this.
+         */
+        upper,
+    };
+
+    struct TableEntry
+    {
+        int score;
+        int depth;
+        Bound bound;
+
+        /**
+         * The best ply found, if any. It comes from whichever position shared the hash, so check it with is_legal
+         * before playing it.
+         */
+        std::optional<Ply> ply = std::nullopt;
+    };
+
+    /**
+     * A fixed-size hash table of search results keyed by Board::hash, so a position reached by a different move order
+     * is not searched again.
+     *
+     * Entries are kept in 64 byte buckets of four, one cache line each, and the bucket count is a power of two so the
+     * hash is reduced with a mask. Each entry is two atomics written without a lock: the packed data, and the key
+     * XORed with the data. A probe only accepts an entry whose two halves agree, so a write torn by another thread
+     * reads as a miss rather than a wrong result. That makes one table safe to share between search threads.
+     */
+    class TranspositionTable
+    {
+    public:
+        /**
+         * Use at most the given number of bytes, rounded down to a power of two buckets. There is always at least one
+         * bucket.
+         */
+        explicit TranspositionTable(std::size_t bytes);
+
+        std::optional<TableEntry> probe(ZobristKey) const;
+
+        /**
+         * Store a result, replacing this position's old entry if there is one, and otherwise the shallowest entry of
+         * the bucket.
+         */
+        void store(ZobristKey, TableEntry);
+
+        /**
+         * Forget every entry. Not safe while other threads are using the table.
+         */
+        void clear();
+
+        std::size_t bucket_count() const;
+
+        static constexpr std::size_t entries_per_bucket = 4;
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint64_t> check{0};
+            std::atomic<std::uint64_t> data{0};
+        };
+
+        struct alignas(64) Bucket
+        {
+            std::array<Entry, entries_per_bucket> entries;
+        };
+
+        static_assert(sizeof(Bucket) == 64, "A bucket should be exactly one cache line");
+
+        Bucket & bucket_of(ZobristKey key) const;
+
+        std::unique_ptr<Bucket[]> m_buckets;
+        std::size_t m_mask;
+    };
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <chess/Bitboard.h>
+#include <chess/Loc.h>
+#include <chess/Square.h>
+
+#include <array>
+#include <cassert>
+#include <optional>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace chess
+{
+    struct Board;
+
+    namespace detail
+    {
+        /**
+         * Attack lookup for a sliding piece on one square. Only the occupancy within the mask can change the attack
+         * set, so it is turned into an index, with PEXT if the target has BMI2 or a magic multiply otherwise, and used
+         * to pick out a precomputed set of attacked squares.
+         */
+        struct SlidingLookup
+        {
+            Bitboard mask;
+            Bitboard magic;
+            Bitboard const* attacks;
+            unsigned shift;
+
+            Bitboard operator()(Bitboard occupied) const
+            {
+#if defined(__BMI2__)
+                return attacks[_pext_u64(occupied, mask)];
+#else
+                return attacks[((occupied & mask) * magic) >> shift];
+#endif
+            }
+        };
+
+        extern std::array<SlidingLookup, Loc::board_size> const rook_lookup;
+        extern std::array<SlidingLookup, Loc::board_size> const bishop_lookup;
+
+        using SquareTable = std::array<Bitboard, Loc::board_size>;
+
+        /**
+         * Loc::add_delta for the generator's own fixed steps, which never go more than two squares either way.
+         *
+         * Works on the 0x88 layout, where each rank is 16 wide and the right half of every rank, along with anything
+         * above or below the board, has bit 3 or 7 set. Stepping off the board in any direction then shows up as a
+         * single mask test, rather than checking x and y against both edges. Steps of more than seven squares would
+         * cross the gap into another rank, so are not allowed.
+         */
+        constexpr std::optional<Loc> step(Loc origin, int dx, int dy)
+        {
+            assert(dx >= -7 && dx <= 7 && dy >= -7 && dy <= 7);
+
+            auto const from = origin.index() + (origin.index() & ~(Loc::side_size - 1));
+            auto const to = from + dy * 16 + dx;
+
+            if (to & 0x88)
+            {
+                return std::nullopt;
+            }
+
+            return Loc{((to >> 4) << 3) | (to & (Loc::side_size - 1))};
+        }
+
+        struct Delta
+        {
+            int dx;
+            int dy;
+        };
+
+        inline constexpr std::array<Delta, 8> knight_deltas = {{{1, 2}, {1, -2}, {-1, 2}, {-1, -2}, {2, 1}, {2, -1}, {-2, 1}, {-2, -1}}};
+        inline constexpr std::array<Delta, 8> king_deltas = {{{0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}}};
+
+        template<std::size_t N>
+        constexpr SquareTable build_leaper_table(std::array<Delta, N> const& deltas)
+        {
+            auto table = SquareTable{};
+
+            for (int index = 0; index < Loc::board_size; ++index)
+            {
+                for (auto [dx, dy] : deltas)
+                {
+                    if (auto dest = step(Loc{index}, dx, dy))
+                    {
+                        table[index] |= bit(*dest);
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        constexpr std::array<SquareTable, 2> build_pawn_table()
+        {
+            auto table = std::array<SquareTable, 2>{};
+            table[static_cast<int>(Colour::white)] = build_leaper_table(std::array<Delta, 2>{{{-1, 1}, {1, 1}}});
+            table[static_cast<int>(Colour::black)] = build_leaper_table(std::array<Delta, 2>{{{-1, -1}, {1, -1}}});
+            return table;
+        }
+
+        /**
+         * Squares from the origin to the edge of the board in one direction, not including the origin.
+         */
+        constexpr Bitboard ray(Loc origin, Delta delta)
+        {
+            auto squares = Bitboard{};
+
+            for (auto current = step(origin, delta.dx, delta.dy); current; current = step(*current, delta.dx, delta.dy))
+            {
+                squares |= bit(*current);
+            }
+
+            return squares;
+        }
+
+        /**
+         * For every pair of aligned squares, either the squares strictly between them or the whole line through them.
+         */
+        constexpr std::array<SquareTable, Loc::board_size> build_line_table(bool whole_line)
+        {
+            auto table = std::array<SquareTable, Loc::board_size>{};
+
+            for (int index = 0; index < Loc::board_size; ++index)
+            {
+                auto const origin = Loc{index};
+
+                for (auto [dx, dy] : king_deltas)
+                {
+                    auto const full_line = ray(origin, {dx, dy}) | ray(origin, {-dx, -dy}) | bit(origin);
+                    auto passed = Bitboard{};
+
+                    for (auto current = step(origin, dx, dy); current; current = step(*current, dx, dy))
+                    {
+                        table[index][current->index()] = whole_line ? full_line : passed;
+                        passed |= bit(*current);
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        // Generated at compile time, so there is nothing to initialise at startup and the compiler can see every
+        // entry.
+        inline constexpr SquareTable knight_table = build_leaper_table(knight_deltas);
+        inline constexpr SquareTable king_table = build_leaper_table(king_deltas);
+        inline constexpr std::array<SquareTable, 2> pawn_table = build_pawn_table();
+        inline constexpr std::array<SquareTable, Loc::board_size> between_table = build_line_table(false);
+        inline constexpr std::array<SquareTable, Loc::board_size> line_table = build_line_table(true);
+    }
+
+    constexpr Bitboard knight_attacks(Loc loc)
+    {
+        return detail::knight_table[loc.index()];
+    }
+
+    constexpr Bitboard king_attacks(Loc loc)
+    {
+        return detail::king_table[loc.index()];
+    }
+
+    /**
+     * Squares a pawn of the given colour on the given square could capture on.
+     */
+    constexpr Bitboard pawn_attacks(Colour colour, Loc loc)
+    {
+        return detail::pawn_table[static_cast<int>(colour)][loc.index()];
+    }
+
+    /**
+     * Squares strictly between two locations on the same rank, file or diagonal. Empty if they are not aligned.
+     */
+    constexpr Bitboard between(Loc a, Loc b)
+    {
+        return detail::between_table[a.index()][b.index()];
+    }
+
+    /**
+     * The whole rank, file or diagonal through two locations, edge to edge. Empty if they are not aligned.
+     */
+    constexpr Bitboard line(Loc a, Loc b)
+    {
+        return detail::line_table[a.index()][b.index()];
+    }
+
+    /**
+     * Squares attacked by a rook on the given square. The first occupied square in each direction is included,
+     * whichever colour it is.
+     */
+    inline Bitboard rook_attacks(Loc loc, Bitboard occupied)
+    {
+        return detail::rook_lookup[loc.index()](occupied);
+    }
+
+    /**
+     * Squares attacked by a bishop on the given square. The first occupied square in each direction is included,
+     * whichever colour it is.
+     */
+    inline Bitboard bishop_attacks(Loc loc, Bitboard occupied)
+    {
+        return detail::bishop_lookup[loc.index()](occupied);
+    }
+
+    inline Bitboard queen_attacks(Loc loc, Bitboard occupied)
+    {
+        return rook_attacks(loc, occupied) | bishop_attacks(loc, occupied);
+    }
+
+    /**
+     * Every piece of the attacking colour that attacks the location, whatever is on it. Sliders are blocked by the
+     * given occupancy rather than the board's, so callers can see through pieces that are about to move.
+     */
+    Bitboard attackers_to(Board const&, Loc, Colour attacker, Bitboard occupied);
+
+    Bitboard attackers_to(Board const&, Loc, Colour attacker);
+
+    /**
+     * Every square attacked by at least one piece of the attacking colour.
+     */
+    Bitboard attacked_by(Board const&, Colour attacker);
+
+    /**
+     * Whether the king of the player to move is attacked. Always false for a side without a king.
+     */
+    bool in_check(Board const&);
+}
@@ -2,13 +2,110 @@
 
 #include <chess/Loc.h>
 #include <chess/Move.h>
+#include <chess/Ply.h>
+#include <perf/StackVector.h>
 
 namespace chess
 {
     struct Board;
 
+    enum class Classification
+    {
+        /**
+         * Work out whether each move causes check or checkmate up front.
+         */
+        eager,
+
+        /**
+         * Leave each move's type as MoveType::unclassified, for callers that only sometimes need it. Use classify to
+         * fill it in.
+         */
+        lazy
+    };
+
     /**
      * Given a board, return all legal moves.
      */
-    std::vector<Move> available_moves(Board const&);
-}
\ No newline at end of file
+    std::vector<Move> available_moves(Board const&, Classification = Classification::eager);
+
+    /**
+     * Given a board, return all legal moves as plies. Much cheaper than available_moves since no resulting boards are
+     * built and moves are not checked for causing check or checkmate.
+     */
+    std::vector<Ply> available_plies(Board const&);
+
+    /**
+     * No legal chess position has more than 218 moves, so this always has room.
+     */
+    using MoveList = perf::StackVector<Ply, 256>;
+
+    /**
+     * Fill the list with all legal plies for the board, replacing whatever it held. Unlike the vector returning
+     * overloads this never allocates, for callers like search and perft that generate moves millions of times.
+     */
+    void available_plies(Board const&, MoveList &);
+
+    /**
+     * A subset of the legal plies, so search can look at the likely best moves before paying to generate the rest.
+     */
+    enum class PlyStage
+    {
+        all,
+
+        /**
+         * Captures, en passant, and promotions whether they capture or not.
+         */
+        captures,
+
+        /**
+         * Everything not in captures, including castling and pawn double jumps.
+         */
+        quiets,
+    };
+
+    /**
+     * Fill the list with the legal plies in the given stage. Stages are generated separately, not filtered out of a
+     * full generation, so asking for captures does none of the work of finding quiet moves.
+     */
+    void available_plies(Board const&, MoveList &, PlyStage);
+
+    /**
+     * Whether the player to move has any legal move, stopping as soon as one is found. Cheaper than generating them
+     * all when only checking for checkmate or stalemate.
+     */
+    bool has_legal_move(Board const&);
+
+    /**
+     * Only the legal captures, en passant captures and promotions, the moves that change the material balance. For
+     * quiescence search and exchange evaluation, which need these far more often than a full generation.
+     */
+    std::vector<Ply> available_captures(Board const&);
+
+    /**
+     * As available_captures, without allocating.
+     */
+    void available_captures(Board const&, MoveList &);
+
+    /**
+     * Whether the ply is legal on the board, for checking a move that came from elsewhere, such as a transposition
+     * table or a killer move from a sibling position.
+     */
+    bool is_legal(Board const&, Ply);
+
+    /**
+     * Build the full Move for a legal ply on the given board, including the resulting board and whether it causes
+     * check or checkmate.
+     */
+    Move to_move(Board const&, Ply, Classification = Classification::eager);
+
+    /**
+     * Whether a legal ply on the given board puts the opponent in check or checkmate. Checkmate needs the opponent's
+     * replies generated, so this is best left until a caller actually wants to know.
+     */
+    MoveType classify(Board const&, Ply);
+
+    /**
+     * Whether a move, from available_moves or to_move, put the opponent in check or checkmate.
+     */
+    MoveType classify(Move const&);
+}
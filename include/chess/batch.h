@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chess/Board.h>
+#include <chess/Ply.h>
+#include <perf/ThreadPool.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace chess
+{
+    /**
+     * The legal plies for each of many independent boards, in the same order as the boards. The boards are shared out
+     * over the pool's threads, each generating into its own scratch list so only the results are allocated.
+     */
+    std::vector<std::vector<Ply>> available_plies(std::vector<Board> const&, perf::ThreadPool &);
+
+    /**
+     * The number of legal plies for each of many independent boards, in the same order as the boards. Nothing is
+     * allocated besides the result.
+     */
+    std::vector<std::size_t> count_plies(std::vector<Board> const&, perf::ThreadPool &);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chess/Board.h>
+#include <chess/Ply.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace chess
+{
+    /**
+     * Count the positions reachable in exactly depth plies, the standard way to check a move generator against known
+     * results. The board is played on and left as it was given.
+     */
+    std::uint64_t perft(Board &, int depth);
+
+    struct PerftDivide
+    {
+        Ply ply;
+        std::uint64_t nodes;
+    };
+
+    /**
+     * Perft split by the first ply, for narrowing down which move a generator gets wrong.
+     */
+    std::vector<PerftDivide> perft_divide(Board &, int depth);
+}
@@ -6,6 +6,7 @@
 
 #include <iosfwd>
 #include <optional>
+#include <stdexcept>
 #include <vector>
 
 namespace chess::pgn
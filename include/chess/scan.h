@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chess/Bitboard.h>
+#include <chess/Loc.h>
+#include <chess/Square.h>
+
+#include <array>
+#include <cstddef>
+
+namespace chess::scan
+{
+    /**
+     * A board's squares, one byte each, so the whole board is a single cache line.
+     */
+    using Squares = std::array<Square, Loc::board_size>;
+
+    /**
+     * The squares whose packed byte, after masking, equals the value. Compares 16 or 32 squares per instruction where
+     * SSE2 or AVX2 is available, and one at a time otherwise.
+     */
+    Bitboard matching(Squares const&, std::byte mask, std::byte value);
+
+    /**
+     * The squares that differ between two boards, including has_moved flags.
+     */
+    Bitboard differing(Squares const&, Squares const&);
+
+    inline Bitboard of_type(Squares const& squares, SquareType type)
+    {
+        return matching(squares, Square::type_mask, static_cast<std::byte>(type));
+    }
+
+    /**
+     * The squares holding a piece of the given colour. Empty squares have no colour, although their colour bit reads
+     * as black.
+     */
+    inline Bitboard of_colour(Squares const& squares, Colour colour)
+    {
+        auto const white = matching(squares, Square::colour_mask, Square::colour_mask);
+        auto const pieces = ~of_type(squares, SquareType::empty);
+        return (colour == Colour::white ? white : ~white) & pieces;
+    }
+
+    namespace detail
+    {
+        /**
+         * The one square at a time versions, always compiled so the vector versions can be checked against them.
+         */
+        Bitboard matching_scalar(Squares const&, std::byte mask, std::byte value);
+        Bitboard differing_scalar(Squares const&, Squares const&);
+    }
+}
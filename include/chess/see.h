@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chess/Ply.h>
+#include <chess/Square.h>
+
+namespace chess
+{
+    struct Board;
+
+    /**
+     * Material value of a piece in hundredths of a pawn, as used by exchange evaluation. The king is worth more than
+     * everything else put together, so trading it is never worth it.
+     */
+    constexpr int piece_value(SquareType type)
+    {
+        switch (type)
+        {
+            case SquareType::empty:
+                return 0;
+            case SquareType::pawn:
+                return 100;
+            case SquareType::knight:
+            case SquareType::bishop:
+                return 300;
+            case SquareType::rook:
+                return 500;
+            case SquareType::queen:
+                return 900;
+            case SquareType::king:
+                return 20000;
+        }
+        return 0;
+    }
+
+    /**
+     * Static exchange evaluation: the material the side to move gains by playing the ply, if both sides then keep
+     * recapturing on its destination with their least valuable piece for as long as that pays. Negative if the ply
+     * loses material. Quiet plies score how much is lost if the piece can be taken, castling always scores 0.
+     *
+     * Only the attack tables are consulted, nothing is searched. Sliders lined up behind a capturing piece join in
+     * once it has gone. Pins are ignored, and only the ply itself can promote.
+     */
+    int see(Board const&, Ply);
+}
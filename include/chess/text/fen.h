@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chess/Board.h>
+
+#include <stdexcept>
+#include <string_view>
+
+namespace chess::text
+{
+    struct FenError : std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * Build a board from Forsyth-Edwards Notation. The move counters are optional and ignored.
+     *
+     * Board has no separate castling rights or en passant square, so these are translated into what it does track.
+     * Kings and rooks are marked as moved unless a castling right needs them not to be, pawns off their starting rank
+     * are marked as moved, and an en passant target square marks the pawn that just double jumped past it.
+     *
+     * Throws FenError if the text is not valid FEN.
+     */
+    Board from_fen(std::string_view fen);
+
+    inline constexpr auto standard_fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+}
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <iosfwd>
+#include <string>
 
 #include <chess/Board.h>
+#include <chess/Ply.h>
 
 namespace chess::text
 {
     void print(std::ostream &, Board const&);
+
+    /**
+     * A ply in coordinate notation, such as e2e4, or e7e8q for a promotion.
+     */
+    std::string to_string(Ply);
 }
\ No newline at end of file
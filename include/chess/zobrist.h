@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chess/Loc.h>
+#include <chess/Square.h>
+
+#include <array>
+#include <cstdint>
+
+namespace chess
+{
+    /**
+     * A 64-bit hash of a position, see Board::hash.
+     */
+    using ZobristKey = std::uint64_t;
+
+    namespace zobrist
+    {
+        namespace detail
+        {
+            constexpr int piece_types = 6;
+            constexpr int piece_keys = 2 * piece_types * Loc::board_size;
+            constexpr int castling_keys = 4;
+            constexpr int en_passant_keys = Loc::side_size;
+            constexpr int key_count = piece_keys + castling_keys + en_passant_keys + 1;
+
+            /**
+             * SplitMix64, good enough to spread keys and simple enough to run at compile time so the keys are the
+             * same on every build.
+             */
+            constexpr std::array<ZobristKey, key_count> generate_keys()
+            {
+                auto keys = std::array<ZobristKey, key_count>{};
+                auto state = ZobristKey{0x9e3779b97f4a7c15ull};
+
+                for (auto & key : keys)
+                {
+                    state += 0x9e3779b97f4a7c15ull;
+                    auto z = state;
+                    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                    key = z ^ (z >> 31);
+                }
+
+                return keys;
+            }
+
+            inline constexpr auto keys = generate_keys();
+        }
+
+        /**
+         * Key for a piece on a square. Must not be called with an empty square.
+         */
+        constexpr ZobristKey piece(Square sq, Loc loc)
+        {
+            auto const colour = static_cast<int>(sq.colour());
+            auto const type = static_cast<int>(sq.type()) - 1;
+            return detail::keys[(colour * detail::piece_types + type) * Loc::board_size + loc.index()];
+        }
+
+        /**
+         * Key for one castling right: white kingside, white queenside, black kingside, black queenside.
+         */
+        constexpr ZobristKey castling(int right)
+        {
+            return detail::keys[detail::piece_keys + right];
+        }
+
+        /**
+         * Key for en passant being possible onto the given file.
+         */
+        constexpr ZobristKey en_passant(int x)
+        {
+            return detail::keys[detail::piece_keys + detail::castling_keys + x];
+        }
+
+        constexpr ZobristKey black_to_move()
+        {
+            return detail::keys[detail::key_count - 1];
+        }
+    }
+}
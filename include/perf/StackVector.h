@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <stdexcept>
@@ -22,6 +23,24 @@ namespace perf
             return m_size;
         }
 
+        constexpr bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        static constexpr std::size_t capacity()
+        {
+            return max_capacity;
+        }
+
+        /**
+         * Forget every element. Nothing needs destroying since elements are trivially destructible.
+         */
+        constexpr void clear()
+        {
+            m_size = 0;
+        }
+
         constexpr void push_back(T element)
         {
             if (m_size == max_capacity) { throw std::logic_error{"Exceeded size"}; }
@@ -35,9 +54,21 @@ namespace perf
             return reinterpret_cast<T&>(m_data[index]);
         }
 
-        constexpr T& operator[](std::size_t index) const
+        constexpr T const& operator[](std::size_t index) const
         {
-            return m_data[index];
+            return reinterpret_cast<T const&>(m_data[index]);
+        }
+
+        /**
+         * Remove the elements in [first, last), shifting later elements down. Pairs with std::remove_if.
+         */
+        constexpr iterator erase(const_iterator first, const_iterator last)
+        {
+            auto const from = begin() + (first - begin());
+            auto const removed = last - first;
+            std::move(from + removed, end(), from);
+            m_size -= removed;
+            return from;
         }
 
         constexpr iterator begin()
@@ -47,7 +78,7 @@ namespace perf
 
         constexpr const_iterator begin() const
         {
-            return reinterpret_cast<T*>(&m_data[0]);
+            return reinterpret_cast<T const*>(&m_data[0]);
         }
 
         constexpr iterator end()
@@ -57,7 +88,7 @@ namespace perf
 
         constexpr const_iterator end() const
         {
-            return reinterpret_cast<T*>(&m_data[0] + m_size);
+            return reinterpret_cast<T const*>(&m_data[0] + m_size);
         }
 
     private:
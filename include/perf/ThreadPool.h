@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace perf
+{
+    /**
+     * A fixed set of worker threads for splitting a range of independent jobs, so batch callers do not each start and
+     * join their own threads.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * Jobs run on the calling thread as well as the workers, so a pool of n threads starts n - 1 of them.
+         */
+        explicit ThreadPool(std::size_t threads = default_threads());
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool & operator=(ThreadPool const&) = delete;
+
+        /**
+         * The number of threads that run jobs, including the calling thread.
+         */
+        std::size_t size() const;
+
+        /**
+         * Call job(begin, end, thread) for contiguous chunks covering [0, count), returning once all of them are done.
+         * thread is below size() and no two chunks run with the same thread at once, so callers can index per-thread
+         * scratch space with it.
+         *
+         * If a job throws, the remaining chunks are skipped and the first exception is rethrown here. Calls from
+         * different threads take turns. A call made from inside a job on this pool runs the whole range inline on
+         * that job's thread, with the same thread index, rather than waiting on workers that are busy with the outer
+         * call.
+         */
+        void for_each_chunk(std::size_t count, std::function<void(std::size_t, std::size_t, std::size_t)> const& job);
+
+        static std::size_t default_threads();
+
+    private:
+        void work(std::size_t thread);
+        void run_chunks(std::size_t thread);
+
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_run_mutex;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+
+        std::function<void(std::size_t, std::size_t, std::size_t)> const * m_job = nullptr;
+        std::size_t m_count = 0;
+        std::size_t m_chunk_size = 1;
+        std::atomic<std::size_t> m_next{0};
+        std::size_t m_busy = 0;
+        std::size_t m_generation = 0;
+        std::exception_ptr m_error;
+        bool m_stopping = false;
+    };
+}
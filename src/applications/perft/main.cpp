@@ -0,0 +1,88 @@
+#include <chess/perft.h>
+#include <chess/text/fen.h>
+#include <chess/text/print.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using chess::text::FenError;
+
+namespace
+{
+    struct Args
+    {
+        int depth = 0;
+        std::string fen = chess::text::standard_fen;
+        std::string error;
+    };
+
+    Args parse_args(int argc, char const ** argv)
+    {
+        Args args{};
+
+        if (argc < 2 || argc > 3)
+        {
+            args.error = "Usage: perft <depth> [fen]";
+            return args;
+        }
+
+        try
+        {
+            args.depth = std::stoi(argv[1]);
+        }
+        catch (std::exception const&)
+        {
+            args.error = std::string{"Depth is not a number: "} + argv[1];
+            return args;
+        }
+
+        if (args.depth < 1)
+        {
+            args.error = "Depth must be at least 1";
+        }
+
+        if (argc == 3)
+        {
+            args.fen = argv[2];
+        }
+
+        return args;
+    }
+}
+
+int main(int argc, char const ** argv)
+{
+    auto args = parse_args(argc, argv);
+
+    if (!args.error.empty())
+    {
+        std::cerr << args.error << '\n';
+        return 1;
+    }
+
+    try
+    {
+        auto board = chess::text::from_fen(args.fen);
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const divide = chess::perft_divide(board, args.depth);
+        auto const elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+
+        auto total = std::uint64_t{};
+        for (auto const& [ply, nodes] : divide)
+        {
+            std::cout << chess::text::to_string(ply) << ": " << nodes << '\n';
+            total += nodes;
+        }
+
+        std::cout << "\nNodes: " << total << '\n';
+        std::cout << "Time: " << elapsed.count() << " s\n";
+        std::cout << "Nodes/second: " << static_cast<std::uint64_t>(total / elapsed.count()) << '\n';
+    }
+    catch (FenError const& e)
+    {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -38,15 +38,17 @@ namespace
         switch (movetype)
         {
             case MoveType::invalid:
-                os << "invalid";
+                return os << "invalid";
             case MoveType::check:
-                os << "check";
+                return os << "check";
             case MoveType::normal:
-                os << "normal";
+                return os << "normal";
             case MoveType::checkmate:
-                os << "checkmate";
+                return os << "checkmate";
             case MoveType::stalemate:
-                os << "stalemate";
+                return os << "stalemate";
+            case MoveType::unclassified:
+                return os << "unclassified";
         }
         return os;
     }
@@ -60,6 +62,9 @@ int main()
     auto move_src = std::string{};
     auto move_dest = std::string{};
 
+    // Kept for the whole game, since the positions searched for one move come up again in the next.
+    auto table = chess::TranspositionTable{64 * 1024 * 1024};
+
     while (last_move == MoveType::normal)
     {
         do
@@ -80,7 +85,7 @@ int main()
         }
         while (last_move == MoveType::invalid);
 
-        auto suggester = chess::Suggester{game.board(), chess::evaluate_with_summation};
+        auto suggester = chess::Suggester{game.board(), chess::evaluate_with_summation, chess::SearchLimits{}, table};
         auto suggestion = suggester.suggest();
         if (suggestion.type != MoveType::invalid)
         {
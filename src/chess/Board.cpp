@@ -1,5 +1,6 @@
 #include <chess/Board.h>
 #include <chess/Move.h>
+#include <chess/scan.h>
 
 using chess::Loc;
 using chess::Move;
@@ -7,6 +8,9 @@ using chess::Board;
 using chess::Square;
 using chess::Colour;
 using chess::SquareType;
+using chess::Ply;
+using chess::PlyKind;
+using chess::ZobristKey;
 
 namespace
 {
@@ -29,6 +33,79 @@ namespace
         b[{6, row}] = chess::Knight(colour);
         b[{7, row}] = chess::Rook(colour);
     }
+
+    /**
+     * Where the rook starts and ends when the king castles between the given squares.
+     */
+    std::pair<Loc, Loc> castling_rook_locs(Ply ply)
+    {
+        auto const y = ply.src().y();
+
+        if (ply.dest().x() > ply.src().x())
+        {
+            return {Loc{Loc::side_size - 1, y}, Loc{ply.dest().x() - 1, y}};
+        }
+        else
+        {
+            return {Loc{0, y}, Loc{ply.dest().x() + 1, y}};
+        }
+    }
+
+    Loc en_passant_capture_loc(Ply ply)
+    {
+        return Loc{ply.dest().x(), ply.src().y()};
+    }
+
+    /**
+     * Castling needs an unmoved king and an unmoved rook in the corner of the king's row, so the right to castle each
+     * way is there for as long as both stay put.
+     */
+    ZobristKey castling_key(Board const& board, Colour colour)
+    {
+        auto const king = board.king(colour);
+        if (!king || board[*king].has_moved())
+        {
+            return 0;
+        }
+
+        auto key = ZobristKey{};
+        auto const first_right = colour == Colour::white ? 0 : 2;
+
+        for (auto [x, right] : {std::pair{Loc::side_size - 1, 0}, std::pair{0, 1}})
+        {
+            auto const rook = board[Loc{x, king->y()}];
+            if (rook == chess::Rook(colour) && !rook.has_moved())
+            {
+                key ^= chess::zobrist::castling(first_right + right);
+            }
+        }
+
+        return key;
+    }
+
+    /**
+     * Only counts en passant if a pawn is actually there to take, so the position after a double jump with nothing
+     * beside it matches the same position reached any other way.
+     */
+    ZobristKey en_passant_key(Board const& board)
+    {
+        auto const jumped = board.last_turn_pawn_double_jump_dest;
+        if (!jumped)
+        {
+            return 0;
+        }
+
+        for (auto dx : {-1, 1})
+        {
+            auto const beside = Loc::add_delta(*jumped, dx, 0);
+            if (beside && board[*beside] == chess::Pawn(board.turn))
+            {
+                return chess::zobrist::en_passant(jumped->x());
+            }
+        }
+
+        return 0;
+    }
 }
 
 Board Board::standard()
@@ -53,7 +130,128 @@ Board Board::with_pieces(std::vector<std::pair<Loc, Square>> const& pieces)
     auto b = Board::blank();
     for (auto const& [loc, sq] : pieces)
     {
-        b[loc] = sq;
+        b.squares[loc.index()] = sq;
     }
+    b.rebuild();
     return b;
 }
+
+void Board::rebuild()
+{
+    // Like set, leave the empty bitboard clear.
+    for (int type = static_cast<int>(SquareType::pawn); type < static_cast<int>(m_types.size()); ++type)
+    {
+        m_types[type] = scan::of_type(squares, static_cast<SquareType>(type));
+    }
+
+    for (auto colour : {Colour::black, Colour::white})
+    {
+        m_colours[static_cast<int>(colour)] = scan::of_colour(squares, colour);
+    }
+
+    m_piece_key = 0;
+    for (auto loc : locs_of(occupied()))
+    {
+        m_piece_key ^= zobrist::piece(squares[loc.index()], loc);
+    }
+}
+
+bool chess::operator==(Board const& lhs, Board const& rhs)
+{
+    return lhs.turn == rhs.turn
+           && lhs.last_turn_pawn_double_jump_dest == rhs.last_turn_pawn_double_jump_dest
+           && scan::differing(lhs.squares, rhs.squares) == 0;
+}
+
+bool chess::operator!=(Board const& lhs, Board const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+ZobristKey Board::hash() const
+{
+    auto key = m_piece_key;
+    key ^= castling_key(*this, Colour::white);
+    key ^= castling_key(*this, Colour::black);
+    key ^= en_passant_key(*this);
+
+    if (turn == Colour::black)
+    {
+        key ^= zobrist::black_to_move();
+    }
+
+    return key;
+}
+
+chess::Undo Board::make(Ply ply)
+{
+    auto const moving = squares[ply.src().index()];
+    auto undo = Undo{moving, squares[ply.dest().index()], last_turn_pawn_double_jump_dest};
+
+    auto moved = moving;
+    moved.set_moved();
+
+    turn = flip_colour(turn);
+    last_turn_pawn_double_jump_dest = std::nullopt;
+    set(ply.src(), Empty());
+    set(ply.dest(), moved);
+
+    switch (ply.kind())
+    {
+        case PlyKind::normal:
+            break;
+        case PlyKind::pawn_double_jump:
+            last_turn_pawn_double_jump_dest = ply.dest();
+            break;
+        case PlyKind::en_passant:
+        {
+            auto const captured_loc = en_passant_capture_loc(ply);
+            undo.captured = squares[captured_loc.index()];
+            set(captured_loc, Empty());
+            break;
+        }
+        case PlyKind::castling:
+        {
+            auto const [rook_src, rook_dest] = castling_rook_locs(ply);
+            auto rook = squares[rook_src.index()];
+            rook.set_moved();
+            set(rook_src, Empty());
+            set(rook_dest, rook);
+            break;
+        }
+        case PlyKind::promotion:
+            moved.set_type(ply.promotion());
+            set(ply.dest(), moved);
+            break;
+    }
+
+    return undo;
+}
+
+void Board::unmake(Ply ply, Undo const& undo)
+{
+    turn = flip_colour(turn);
+    last_turn_pawn_double_jump_dest = undo.last_turn_pawn_double_jump_dest;
+    set(ply.src(), undo.moved);
+
+    switch (ply.kind())
+    {
+        case PlyKind::en_passant:
+            set(ply.dest(), Empty());
+            set(en_passant_capture_loc(ply), undo.captured);
+            break;
+        case PlyKind::castling:
+        {
+            // Castling is only allowed with a rook that has never moved, so it goes back unmoved.
+            auto const [rook_src, rook_dest] = castling_rook_locs(ply);
+            auto const rook = squares[rook_dest.index()];
+            set(rook_dest, Empty());
+            set(rook_src, Square{rook.type(), rook.colour()});
+            set(ply.dest(), undo.captured);
+            break;
+        }
+        default:
+            set(ply.dest(), undo.captured);
+            break;
+    }
+}
@@ -14,18 +14,9 @@ using chess::Square;
 using chess::Colour;
 using chess::Move;
 using chess::SquareType;
-
-namespace
-{
-    std::vector<Move> get_moves_for(Game const &game, Loc src)
-    {
-        auto moves = chess::available_moves(game.board());
-        auto it = std::remove_if(begin(moves), end(moves), [&src](auto move) { return move.src != src; });
-        moves.erase(it, end(moves));
-
-        return moves;
-    }
-}
+using chess::Ply;
+using chess::Classification;
+using chess::MoveList;
 
 Game::Game(Driver & driver) : Game{driver, Board::standard()}
 {}
@@ -47,14 +38,19 @@ Colour Game::current_turn() const
 
 MoveType Game::move(Loc src, Loc dest)
 {
-    auto moves = get_moves_for(*this, src);
-    auto move_it = std::find_if(begin(moves), end(moves), [dest](Move m) { return m.dest == dest; });
+    auto plies = MoveList{};
+    available_plies(m_board, plies);
+    auto ply_it = std::find_if(plies.begin(), plies.end(), [src, dest](Ply p)
+    {
+        return p.src() == src && p.dest() == dest;
+    });
 
-    if (move_it != std::end(moves))
+    if (ply_it != plies.end())
     {
-        handle_promotion(*move_it);
-        m_board = move_it->result;
-        return handle_mate(*move_it);
+        auto move = to_move(m_board, *ply_it, Classification::lazy);
+        handle_promotion(move);
+        m_board = move.result;
+        return handle_mate(move);
     }
 
     return MoveType::invalid;
@@ -83,12 +79,10 @@ void Game::handle_promotion(chess::Move & move)
 
 MoveType Game::handle_mate(Move const &move)
 {
-    auto moves = available_moves(m_board);
-    // TODO: Don't need to get available moves, need available_moves from before to distinguish between checkmate and
-    // stalemate. Though might take even more computation...
-    if (moves.empty())
+    if (!has_legal_move(m_board))
     {
-        if (move.type == MoveType::checkmate)
+        // Only worth knowing whether the mover gave check once the opponent is known to be stuck.
+        if (classify(move) == MoveType::checkmate)
         {
             m_driver.checkmate(*this, move);
             return MoveType::checkmate;
@@ -1,7 +1,9 @@
 #include <chess/Loc.h>
 #include <perf/StackVector.h>
 
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 
 using chess::LocInvalid;
 using chess::Loc;
@@ -21,70 +23,64 @@ namespace
         return all;
     }
 
-    perf::StackVector<Loc, Loc::side_size> generate_direction(Loc origin, Sign x, Sign y)
+    constexpr int sign_to_hops(Sign sign, int start)
     {
-        auto locs = perf::StackVector<Loc, 8>{};
-
-        auto sign_to_hops = [](Sign sign, int start)
+        switch (sign)
         {
-            switch (sign)
-            {
-                case Sign::positive:
-                    return Loc::side_size - 1 - start;
-                case Sign::none:
-                    return Loc::side_size - 1;
-                case Sign::negative:
-                    return start;
-            }
-        };
+            case Sign::positive:
+                return Loc::side_size - 1 - start;
+            case Sign::negative:
+                return start;
+            case Sign::none:
+            default:
+                return Loc::side_size - 1;
+        }
+    }
 
+    /**
+     * How many squares there are from the origin to the edge of the board in the given direction.
+     */
+    constexpr int direction_hops(Loc origin, Sign x, Sign y)
+    {
         auto max_hops_x = sign_to_hops(x, origin.x());
         auto max_hops_y = sign_to_hops(y, origin.y());
-        auto max_hops = std::min(max_hops_x, max_hops_y);
-        auto hop = static_cast<int>(y)*Loc::side_size + static_cast<int>(x);
-
-        auto current = origin.index();
-        for (int i = 0; i < max_hops; ++i)
-        {
-            current += hop;
-            locs.push_back(Loc{current});
-        }
-
-        return locs;
+        return std::min(max_hops_x, max_hops_y);
     }
 
-        std::size_t direction_lookup_index(Loc loc, Sign x, Sign y)
-        {
-            auto loc_part = loc.index() << 4;
-            auto x_part = (static_cast<int>(x) + 1) << 2;
-            auto y_part = (static_cast<int>(y) + 1);
-            return loc_part | x_part | y_part;
-        }
+    constexpr std::size_t direction_lookup_index(Loc loc, Sign x, Sign y)
+    {
+        auto loc_part = loc.index() << 4;
+        auto x_part = (static_cast<int>(x) + 1) << 2;
+        auto y_part = (static_cast<int>(y) + 1);
+        return loc_part | x_part | y_part;
+    }
 
-        static constexpr std::size_t direction_lookup_size = (64 << 4) + (2 << 2) + 2 + 1;
+    constexpr std::size_t direction_lookup_size = (64 << 4) + (2 << 2) + 2 + 1;
 
-    std::array<perf::StackVector<Loc, 8>, direction_lookup_size> generate_direction_lookup_map()
+    /**
+     * Only the number of hops in each direction is stored, the locations themselves are quick to step through. That
+     * keeps the table small enough to build at compile time.
+     */
+    constexpr std::array<std::int8_t, direction_lookup_size> generate_direction_lookup()
     {
-        std::array<perf::StackVector<Loc, 8>, direction_lookup_size> map;
-        std::array<Sign, 3> signs = {Sign::positive, Sign::none, Sign::negative};
+        auto lookup = std::array<std::int8_t, direction_lookup_size>{};
+        constexpr std::array<Sign, 3> signs = {Sign::positive, Sign::none, Sign::negative};
 
-        for (auto loc : Loc::all_squares())
+        for (int index = 0; index < Loc::board_size; ++index)
         {
             for (auto x : signs)
             {
                 for (auto y : signs)
                 {
-                    auto key = direction_lookup_index(loc, x, y);
-                    auto value = generate_direction(loc, x, y);
-                    map[key] = value;
+                    lookup[direction_lookup_index(index, x, y)] = static_cast<std::int8_t>(direction_hops(index, x, y));
                 }
             }
         }
 
-        return map;
+        return lookup;
     }
 
-    auto direction_lookup = generate_direction_lookup_map();
+    constexpr auto direction_lookup = generate_direction_lookup();
 }
 
 LocInvalid::LocInvalid(int x, int y) : std::runtime_error{"Invalid Loc m_x=" + std::to_string(x) + ", y=" + std::to_string(y)}
@@ -111,7 +107,18 @@ std::vector<Loc> const& Loc::all_squares()
 
 perf::StackVector<Loc, Loc::side_size> Loc::direction(Loc origin, Sign x, Sign y)
 {
-    return direction_lookup[direction_lookup_index(origin, x, y)];
+    auto locs = perf::StackVector<Loc, side_size>{};
+    auto const hops = direction_lookup[direction_lookup_index(origin, x, y)];
+    auto const hop = static_cast<int>(y) * side_size + static_cast<int>(x);
+
+    auto current = origin.index();
+    for (int i = 0; i < hops; ++i)
+    {
+        current += hop;
+        locs.push_back(Loc{current});
+    }
+
+    return locs;
 }
 
 bool chess::operator==(Loc lhs, Loc rhs)
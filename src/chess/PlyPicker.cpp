@@ -0,0 +1,249 @@
+#include <chess/PlyPicker.h>
+#include <chess/see.h>
+
+#include <array>
+
+using chess::PlyPicker;
+using chess::History;
+using chess::Board;
+using chess::Colour;
+using chess::Ply;
+using chess::PlyKind;
+using chess::PlyStage;
+using chess::SquareType;
+
+namespace
+{
+    // Halve every score once one gets this big, so old cutoffs fade and nothing overflows.
+    constexpr int history_limit = 1 << 20;
+
+    /**
+     * Most valuable victim first, then least valuable attacker. A promotion counts the piece it gains as its victim.
+     */
+    int mvv_lva(Board const& board, Ply ply)
+    {
+        auto victim = chess::piece_value(board[ply.dest()].type());
+        if (ply.kind() == PlyKind::en_passant)
+        {
+            victim = chess::piece_value(SquareType::pawn);
+        }
+        if (ply.kind() == PlyKind::promotion)
+        {
+            victim += chess::piece_value(ply.promotion());
+        }
+
+        // Victim values are multiples of 100 and no attacker but the king is worth that much, so the attacker only
+        // breaks ties. The king can only take undefended pieces, so may as well go first.
+        auto const attacker = board[ply.src()].type();
+        return victim * 10 - (attacker == SquareType::king ? 0 : chess::piece_value(attacker) / 100);
+    }
+
+    /**
+     * Stable insertion sort, highest score first. Each ply is scored once up front, into a buffer alongside the list.
+     * The lists are short, and unlike std::stable_sort it never allocates a buffer, which search relies on.
+     */
+    template<typename ScoreFunc>
+    void sort_by_score(chess::MoveList & plies, ScoreFunc const& score)
+    {
+        auto scores = std::array<int, chess::MoveList::capacity()>{};
+        for (std::size_t i = 0; i < plies.size(); ++i)
+        {
+            scores[i] = score(plies[i]);
+        }
+
+        for (std::size_t i = 1; i < plies.size(); ++i)
+        {
+            auto const ply = plies[i];
+            auto const ply_score = scores[i];
+            auto j = i;
+
+            for (; j > 0 && scores[j - 1] < ply_score; --j)
+            {
+                plies[j] = plies[j - 1];
+                scores[j] = scores[j - 1];
+            }
+            plies[j] = ply;
+            scores[j] = ply_score;
+        }
+    }
+
+    /**
+     * Whether the capture could lose material, which is only possible if the capturing piece is worth more than what
+     * it takes.
+     */
+    bool may_lose(Board const& board, Ply ply)
+    {
+        auto const attacker = board[ply.src()].type();
+        auto const victim = board[ply.dest()].type();
+        return ply.kind() == PlyKind::normal && attacker != SquareType::king
+               && chess::piece_value(attacker) > chess::piece_value(victim);
+    }
+}
+
+bool chess::is_quiet(Board const& board, Ply ply)
+{
+    return ply.kind() != PlyKind::en_passant
+           && ply.kind() != PlyKind::promotion
+           && !contains(board.pieces(flip_colour(board.turn)), ply.dest());
+}
+
+void History::reward(Colour colour, Ply ply, int depth)
+{
+    auto & table = m_table[static_cast<int>(colour)];
+    auto & entry = table[ply.src().index()][ply.dest().index()];
+    entry += depth * depth;
+
+    if (entry >= history_limit)
+    {
+        for (auto & row : table)
+        {
+            for (auto & score : row)
+            {
+                score /= 2;
+            }
+        }
+    }
+}
+
+int History::score(Colour colour, Ply ply) const
+{
+    return m_table[static_cast<int>(colour)][ply.src().index()][ply.dest().index()];
+}
+
+void History::clear()
+{
+    m_table = {};
+}
+
+PlyPicker::PlyPicker(Board const& board, std::optional<Ply> hash_ply, Killers killers, History const * history) :
+        m_board{board},
+        m_hash_ply{hash_ply},
+        m_killers{killers},
+        m_history{history}
+{
+    // Drop anything not legal here up front, so later stages can skip them without checking again.
+    if (m_hash_ply && !is_legal(m_board, *m_hash_ply))
+    {
+        m_hash_ply = std::nullopt;
+    }
+
+    for (auto & killer : m_killers)
+    {
+        if (killer && (killer == m_hash_ply || !is_quiet(m_board, *killer) || !is_legal(m_board, *killer)))
+        {
+            killer = std::nullopt;
+        }
+    }
+
+    if (m_killers[0] == m_killers[1])
+    {
+        m_killers[1] = std::nullopt;
+    }
+}
+
+std::optional<Ply> PlyPicker::next()
+{
+    while (true)
+    {
+        switch (m_stage)
+        {
+            case Stage::hash:
+                m_stage = Stage::generate_captures;
+                if (m_hash_ply)
+                {
+                    return m_hash_ply;
+                }
+                break;
+
+            case Stage::generate_captures:
+                available_captures(m_board, m_plies);
+                order_captures();
+                m_index = 0;
+                m_stage = Stage::captures;
+                break;
+
+            case Stage::captures:
+            case Stage::quiets:
+                while (m_index < m_plies.size())
+                {
+                    auto const ply = m_plies[m_index++];
+                    if (!already_given(ply))
+                    {
+                        return ply;
+                    }
+                }
+                m_stage = m_stage == Stage::captures ? Stage::killers : Stage::losing_captures;
+                m_index = 0;
+                break;
+
+            case Stage::killers:
+                while (m_index < m_killers.size())
+                {
+                    auto const killer = m_killers[m_index++];
+                    if (killer)
+                    {
+                        return killer;
+                    }
+                }
+                m_stage = Stage::generate_quiets;
+                break;
+
+            case Stage::generate_quiets:
+                available_plies(m_board, m_plies, PlyStage::quiets);
+                if (m_history)
+                {
+                    auto const colour = m_board.turn;
+                    sort_by_score(m_plies, [&](Ply ply) { return m_history->score(colour, ply); });
+                }
+                m_index = 0;
+                m_stage = Stage::quiets;
+                break;
+
+            case Stage::losing_captures:
+                while (m_index < m_losing_captures.size())
+                {
+                    auto const ply = m_losing_captures[m_index++];
+                    if (!already_given(ply))
+                    {
+                        return ply;
+                    }
+                }
+                m_stage = Stage::done;
+                break;
+
+            case Stage::done:
+                return std::nullopt;
+        }
+    }
+}
+
+void PlyPicker::order_captures()
+{
+    m_losing_captures.clear();
+    auto kept = m_plies.begin();
+
+    for (auto ply : m_plies)
+    {
+        if (may_lose(m_board, ply) && see(m_board, ply) < 0)
+        {
+            m_losing_captures.push_back(ply);
+        }
+        else
+        {
+            *kept++ = ply;
+        }
+    }
+    m_plies.erase(kept, m_plies.end());
+
+    sort_by_score(m_plies, [this](Ply ply) { return mvv_lva(m_board, ply); });
+}
+
+bool PlyPicker::already_given(Ply ply) const
+{
+    if (ply == m_hash_ply)
+    {
+        return true;
+    }
+
+    return m_stage == Stage::quiets && (ply == m_killers[0] || ply == m_killers[1]);
+}
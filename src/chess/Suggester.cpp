@@ -1,5 +1,13 @@
 #include <chess/Suggester.h>
 #include <chess/available_moves.h>
+#include <chess/PlyPicker.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <vector>
 
 using chess::Suggester;
 using chess::SquareType;
@@ -7,6 +15,18 @@ using chess::Square;
 using chess::Move;
 using chess::Score;
 using chess::Colour;
+using chess::Ply;
+using chess::Board;
+using chess::MoveList;
+using chess::EvalFunc;
+using chess::SearchLimits;
+using chess::SearchResult;
+using chess::TranspositionTable;
+using chess::TableEntry;
+using chess::Bound;
+using chess::History;
+using chess::PlyPicker;
+using chess::ZobristKey;
 
 namespace
 {
@@ -34,81 +54,362 @@ namespace
         auto base = score_type(sq.type());
         return sq.colour() == Colour::white ? base : -base;
     }
-}
 
-Suggester::Suggester(Board board, EvalFunc eval_func) :
-    m_current{std::move(board)},
-    m_eval{std::move(eval_func)},
-    m_tree{Evaluation{0, Move{"A1", "A1", m_current}}}
-{
-    auto depth = 4;
-    build_tree(m_tree, depth);
-}
+    // Not the real limits, so either can be negated.
+    constexpr Score infinity = std::numeric_limits<Score>::max();
 
-void Suggester::build_tree(Tree<Evaluation> & root, int depth)
-{
-    auto const& board = root.value().move.result;
+    // Reading the clock costs more than visiting a node, so it is only looked at this often.
+    constexpr std::uint64_t clock_check_interval = 1024;
 
-    if (depth == 0)
+    /**
+     * Depth-first alpha-beta search in negamax form: every score is from the point of view of the side making the
+     * ply, so each side maximises and the opponent's window is ours negated. Only the line being looked at is ever
+     * held, on the one board that is played on and restored.
+     *
+     * Each ply of the line gets its own frame from a stack allocated once up front, so the memory a search needs is
+     * fixed by its depth and nothing is allocated while it runs. Below the root, replies are tried in the order a
+     * PlyPicker gives them, fed with the transposition table's best ply, the killers for that height and the history
+     * of cutoffs so far. The root plies are ordered the same way, with the last iteration's best first, and ties still
+     * go to the first ply generated.
+     */
+    struct Search
     {
-        root.value().score = m_eval(root.value().move);
-        return;
-    }
+        using Clock = std::chrono::steady_clock;
 
-    auto moves = available_moves(board);
+        Search(EvalFunc const& eval, SearchLimits const& limits, TranspositionTable * table) :
+            m_eval{eval},
+            m_limits{limits},
+            m_table{table},
+            m_start{Clock::now()},
+            m_stack(static_cast<std::size_t>(limits.depth))
+        {}
 
-    if (moves.empty())
-    {
-        root.value().score = m_eval(root.value().move);
-        return;
-    }
+        MoveList & root_plies()
+        {
+            return m_root_plies;
+        }
 
-    for (auto const& move : moves)
-    {
-        auto & child = root.add_child(Evaluation{0, move});
-        build_tree(child, depth - 1);
-    }
+        std::uint64_t nodes() const
+        {
+            return m_nodes;
+        }
 
-    // Layer below us is already evaluated due to recursion
-    auto const& children = root.children();
-    auto score = Score{};
-    auto maximise = [](Score current, Score child) { return std::max(current, child); };
-    auto minimise = [](Score current, Score child) { return std::min(current, child); };
-    auto compare = root.value().move.result.turn == Colour::white ? maximise : minimise;
+        /**
+         * Whether running out of time or nodes may stop the search. Until it is allowed an iteration always finishes.
+         */
+        void allow_stopping(bool allow)
+        {
+            m_can_stop = allow;
+        }
 
-    for (auto const& child : children)
-    {
-        score = compare(child.value().score, score);
-    }
+        /**
+         * The best of the root plies, already generated into root_plies, searching depth plies. Nothing if the
+         * search ran out of budget before finishing. A finished search is stored in the table under the root, and the
+         * next iteration tries its best ply first.
+         */
+        std::optional<Ply> best_root_ply(Board & board, int depth)
+        {
+            order_root_plies(board);
 
-    root.value().score = score;
-}
+            auto best = m_root_order[0];
+            auto best_generated = m_root_generated[0];
+            auto alpha = -infinity;
 
-Move Suggester::suggest() const
-{
-    Evaluation const * min = nullptr;
-    Evaluation const * max = nullptr;
+            for (std::size_t i = 0; i < m_root_order.size(); ++i)
+            {
+                auto const ply = m_root_order[i];
+                auto const generated = m_root_generated[i];
 
-    for (auto const& child : m_tree.children())
-    {
-        auto score = child.value().score;
-        if (!min || score < min->score)
+                // Ties go to the first ply generated, whatever order they are searched in. A ply generated before the
+                // best so far only needs to match it, so is searched with a window one lower.
+                auto const ties_win = alpha != -infinity && generated < best_generated;
+                auto const floor = ties_win ? alpha - 1 : alpha;
+
+                auto const score = score_ply(board, ply, 0, depth, floor, infinity);
+                if (m_stopped)
+                {
+                    return std::nullopt;
+                }
+
+                if (score > floor)
+                {
+                    best = ply;
+                    best_generated = generated;
+                    alpha = score;
+                }
+            }
+
+            if (m_table)
+            {
+                m_table->store(board.hash(), TableEntry{alpha, depth, Bound::exact, best});
+            }
+
+            m_root_best = best;
+            return best;
+        }
+
+    private:
+        /**
+         * What each height of the line keeps while it is searched, and between visits for killers.
+         */
+        struct Frame
+        {
+            std::optional<PlyPicker> picker;
+            PlyPicker::Killers killers;
+        };
+
+        /**
+         * The frame for the given number of plies from the root, which is height 0.
+         */
+        Frame & frame_at(int height)
         {
-            min = &child.value();
+            return m_stack[static_cast<std::size_t>(height)];
         }
 
-        if (!max || score > max->score)
+        /**
+         * Put the root plies in the order to search them, remembering where each was generated. The last iteration's
+         * best ply goes first, taken from the table if it has the root so one left by an earlier search counts too,
+         * and the rest follow in the order a PlyPicker gives them.
+         */
+        void order_root_plies(Board const& board)
         {
-            max = &child.value();
+            auto const entry = m_table ? m_table->probe(board.hash()) : std::nullopt;
+            auto const first = entry && entry->ply ? entry->ply : m_root_best;
+            auto picker = PlyPicker{board, first, {}, &m_history};
+
+            m_root_order.clear();
+            for (auto ply = picker.next(); ply; ply = picker.next())
+            {
+                auto const generated = std::find(m_root_plies.begin(), m_root_plies.end(), *ply);
+                m_root_generated[m_root_order.size()] = static_cast<std::size_t>(generated - m_root_plies.begin());
+                m_root_order.push_back(*ply);
+            }
         }
+
+        /**
+         * Score of playing the ply on the board, searching depth plies including this one. Exact if it lies within
+         * (alpha, beta), otherwise only a bound on that side of the window, which is all the caller needs to know to
+         * discard it. The ply is one of those at the given height.
+         *
+         * Once the search has stopped the score means nothing, and the board is put back without looking further.
+         */
+        Score score_ply(Board & board, Ply ply, int height, int depth, Score alpha, Score beta)
+        {
+            if (out_of_budget())
+            {
+                m_stopped = true;
+                return 0;
+            }
+            ++m_nodes;
+
+            auto const sign = board.turn == Colour::white ? 1 : -1;
+
+            if (depth == 1)
+            {
+                return sign * m_eval(to_move(board, ply));
+            }
+
+            auto undo = board.make(ply);
+
+            // From here on scores are the opponent's, for the position after the ply.
+            auto const node_alpha = -beta;
+            auto const node_beta = -alpha;
+            auto const node_depth = depth - 1;
+            auto const key = board.hash();
+            auto const entry = m_table ? m_table->probe(key) : std::nullopt;
+
+            if (auto const stored = settles(entry, node_depth, node_alpha, node_beta))
+            {
+                board.unmake(ply, undo);
+                return -*stored;
+            }
+
+            auto & frame = frame_at(height + 1);
+            auto & picker = frame.picker.emplace(board, entry ? entry->ply : std::nullopt, frame.killers, &m_history);
+            auto reply = picker.next();
+
+            // Checkmate and stalemate end the line early, and are scored like any other leaf.
+            if (!reply)
+            {
+                board.unmake(ply, undo);
+                return sign * m_eval(to_move(board, ply));
+            }
+
+            auto best = -infinity;
+            auto best_reply = *reply;
+            auto reply_alpha = node_alpha;
+
+            for (; reply; reply = picker.next())
+            {
+                auto const score = score_ply(board, *reply, height + 1, node_depth, reply_alpha, node_beta);
+                if (score > best)
+                {
+                    best = score;
+                    best_reply = *reply;
+                }
+                reply_alpha = std::max(reply_alpha, best);
+
+                if (m_stopped)
+                {
+                    break;
+                }
+
+                // The opponent already has a reply good enough that we would never play this ply.
+                if (reply_alpha >= node_beta)
+                {
+                    if (is_quiet(board, *reply))
+                    {
+                        remember_cutoff(frame, board.turn, *reply, node_depth);
+                    }
+                    break;
+                }
+            }
+
+            if (m_table && !m_stopped)
+            {
+                // Only an exact result knows its best reply. When nothing beat the window every reply was only bounded,
+                // and a cutoff only shows the first reply that was good enough for this window. Tried first in later
+                // searches, those took more nodes than the picker's own order.
+                auto const bound = best <= node_alpha ? Bound::upper : best >= node_beta ? Bound::lower : Bound::exact;
+                auto const stored_reply = bound == Bound::exact ? std::optional<Ply>{best_reply} : std::nullopt;
+                m_table->store(key, TableEntry{best, node_depth, bound, stored_reply});
+            }
+
+            board.unmake(ply, undo);
+            return -best;
+        }
+
+        /**
+         * A quiet ply that cut off is likely to again in sibling positions, and anywhere else it can be played.
+         */
+        void remember_cutoff(Frame & frame, Colour colour, Ply ply, int depth)
+        {
+            if (frame.killers[0] != ply)
+            {
+                frame.killers[1] = frame.killers[0];
+                frame.killers[0] = ply;
+            }
+            m_history.reward(colour, ply, depth);
+        }
+
+        /**
+         * A stored score that settles the position for the window without searching it, if the entry is from a search
+         * at least as deep.
+         */
+        static std::optional<Score> settles(std::optional<TableEntry> const& entry, int depth, Score alpha, Score beta)
+        {
+            if (!entry || entry->depth < depth)
+            {
+                return std::nullopt;
+            }
+
+            switch (entry->bound)
+            {
+                case Bound::exact:
+                    return entry->score;
+                case Bound::lower:
+                    return entry->score >= beta ? std::optional<Score>{entry->score} : std::nullopt;
+                case Bound::upper:
+                    return entry->score <= alpha ? std::optional<Score>{entry->score} : std::nullopt;
+                case Bound::none:
+                    break;
+            }
+
+            return std::nullopt;
+        }
+
+        bool out_of_budget() const
+        {
+            if (m_stopped)
+            {
+                return true;
+            }
+
+            if (!m_can_stop)
+            {
+                return false;
+            }
+
+            if (m_limits.nodes && m_nodes >= *m_limits.nodes)
+            {
+                return true;
+            }
+
+            return m_limits.time
+                   && m_nodes % clock_check_interval == 0
+                   && Clock::now() - m_start >= *m_limits.time;
+        }
+
+        EvalFunc const& m_eval;
+        SearchLimits const& m_limits;
+        TranspositionTable * m_table;
+        Clock::time_point m_start;
+        MoveList m_root_plies;
+        MoveList m_root_order;
+        std::array<std::size_t, MoveList::capacity()> m_root_generated = {};
+        std::optional<Ply> m_root_best;
+        std::vector<Frame> m_stack;
+        History m_history;
+        std::uint64_t m_nodes = 0;
+        bool m_can_stop = false;
+        bool m_stopped = false;
+    };
+}
+
+Suggester::Suggester(Board board, EvalFunc eval_func, int depth) :
+    Suggester{std::move(board), std::move(eval_func), SearchLimits{depth}}
+{
+}
+
+Suggester::Suggester(Board board, EvalFunc eval_func, SearchLimits limits) :
+    m_current{std::move(board)},
+    m_eval{std::move(eval_func)},
+    m_limits{limits}
+{
+    m_limits.depth = std::max(m_limits.depth, 1);
+}
+
+Suggester::Suggester(Board board, EvalFunc eval_func, SearchLimits limits, TranspositionTable & table) :
+    Suggester{std::move(board), std::move(eval_func), limits}
+{
+    m_table = &table;
+}
+
+SearchResult Suggester::search() const
+{
+    auto board = m_current;
+    auto search = Search{m_eval, m_limits, m_table};
+    auto & plies = search.root_plies();
+    available_plies(board, plies);
+
+    if (plies.empty())
+    {
+        return SearchResult{Move{"A1", "A1", Board::blank(), MoveType::invalid}};
     }
 
-    if (!min || !max)
+    auto best = plies[0];
+    auto depth_reached = 0;
+
+    for (int depth = 1; depth <= m_limits.depth; ++depth)
     {
-        return Move{"A1", "A1", Board::blank(), MoveType::invalid};
+        search.allow_stopping(depth > 1);
+
+        auto const found = search.best_root_ply(board, depth);
+        if (!found)
+        {
+            break;
+        }
+
+        best = *found;
+        depth_reached = depth;
     }
 
-    return m_current.turn == Colour::white ? max->move : min->move;
+    return SearchResult{to_move(m_current, best), depth_reached, search.nodes()};
+}
+
+Move Suggester::suggest() const
+{
+    return search().move;
 }
 
 Score chess::evaluate_with_summation(Move const& move)
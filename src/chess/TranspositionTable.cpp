@@ -0,0 +1,125 @@
+#include <chess/TranspositionTable.h>
+
+#include <algorithm>
+
+using chess::Bound;
+using chess::Ply;
+using chess::TableEntry;
+using chess::TranspositionTable;
+using chess::ZobristKey;
+
+namespace
+{
+    // Packed as score in the low 32 bits, then the ply, the depth and the bound. A zero ply is A1 to A1, which is
+    // never legal, so it stands for no ply.
+    constexpr int ply_shift = 32;
+    constexpr int depth_shift = 48;
+    constexpr int bound_shift = 56;
+
+    std::uint64_t pack(TableEntry const& entry)
+    {
+        auto const ply = entry.ply ? entry.ply->raw() : std::uint16_t{0};
+        return static_cast<std::uint32_t>(entry.score)
+               | (std::uint64_t{ply} << ply_shift)
+               | (std::uint64_t{static_cast<std::uint8_t>(entry.depth)} << depth_shift)
+               | (std::uint64_t{static_cast<std::uint8_t>(entry.bound)} << bound_shift);
+    }
+
+    TableEntry unpack(std::uint64_t data)
+    {
+        auto const ply = static_cast<std::uint16_t>(data >> ply_shift);
+        return TableEntry{
+                static_cast<std::int32_t>(static_cast<std::uint32_t>(data)),
+                static_cast<std::uint8_t>(data >> depth_shift),
+                static_cast<Bound>(static_cast<std::uint8_t>(data >> bound_shift)),
+                ply ? std::optional<Ply>{Ply::from_raw(ply)} : std::nullopt,
+        };
+    }
+
+    int depth_of(std::uint64_t data)
+    {
+        return static_cast<std::uint8_t>(data >> depth_shift);
+    }
+
+    std::size_t floor_power_of_two(std::size_t n)
+    {
+        auto power = std::size_t{1};
+        while (power <= n / 2)
+        {
+            power *= 2;
+        }
+        return power;
+    }
+}
+
+TranspositionTable::TranspositionTable(std::size_t bytes) :
+    m_mask{floor_power_of_two(std::max<std::size_t>(bytes / sizeof(Bucket), 1)) - 1}
+{
+    m_buckets = std::make_unique<Bucket[]>(m_mask + 1);
+}
+
+std::size_t TranspositionTable::bucket_count() const
+{
+    return m_mask + 1;
+}
+
+TranspositionTable::Bucket & TranspositionTable::bucket_of(ZobristKey key) const
+{
+    return m_buckets[key & m_mask];
+}
+
+std::optional<TableEntry> TranspositionTable::probe(ZobristKey key) const
+{
+    for (auto const& entry : bucket_of(key).entries)
+    {
+        auto const data = entry.data.load(std::memory_order_relaxed);
+        auto const check = entry.check.load(std::memory_order_relaxed);
+
+        if (data != 0 && (check ^ data) == key)
+        {
+            return unpack(data);
+        }
+    }
+
+    return std::nullopt;
+}
+
+void TranspositionTable::store(ZobristKey key, TableEntry entry)
+{
+    auto & bucket = bucket_of(key);
+    auto * replace = &bucket.entries[0];
+    auto replace_depth = depth_of(replace->data.load(std::memory_order_relaxed));
+
+    for (auto & candidate : bucket.entries)
+    {
+        auto const data = candidate.data.load(std::memory_order_relaxed);
+
+        if ((candidate.check.load(std::memory_order_relaxed) ^ data) == key || data == 0)
+        {
+            replace = &candidate;
+            break;
+        }
+
+        if (depth_of(data) < replace_depth)
+        {
+            replace = &candidate;
+            replace_depth = depth_of(data);
+        }
+    }
+
+    auto const data = pack(entry);
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (std::size_t i = 0; i < bucket_count(); ++i)
+    {
+        for (auto & entry : m_buckets[i].entries)
+        {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
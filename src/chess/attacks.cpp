@@ -0,0 +1,224 @@
+#include <chess/attacks.h>
+#include <chess/Board.h>
+
+using chess::Bitboard;
+using chess::Board;
+using chess::SquareType;
+using chess::Loc;
+using chess::Colour;
+using chess::detail::SlidingLookup;
+
+namespace
+{
+    using chess::detail::Delta;
+    using Directions = std::array<Delta, 4>;
+    using Magics = std::array<Bitboard, Loc::board_size>;
+
+    constexpr Directions rook_directions = {{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+    constexpr Directions bishop_directions = {{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+    // Found offline by trying sparse random numbers until one hashed every relevant occupancy of a square without a
+    // destructive collision. Each square uses exactly as many index bits as its mask has.
+    constexpr Magics rook_magics = {
+            0x1080004008801020ull, 0x0840092002c03000ull, 0x1900200010400900ull, 0x0880100008000480ull,
+            0x4200100420080200ull, 0x8100020100080400ull, 0x0200040110886200ull, 0x0200008040220411ull,
+            0x0404800084400220ull, 0x0000401000402000ull, 0x0086001081220440ull, 0x0408800800100280ull,
+            0x000a001201040820ull, 0x8848800200840080ull, 0x4001000100040200ull, 0x0442000102105084ull,
+            0x9080010020804100ull, 0x0040404000201009ull, 0x0000808010002009ull, 0x2200090021d00100ull,
+            0x0008008008040080ull, 0x0004004002010040ull, 0x0011040008015042ull, 0x00000a0001768104ull,
+            0x0000800080204009ull, 0x2010004140002001ull, 0x9800200280100080ull, 0x1000100080080080ull,
+            0x0442000a00049020ull, 0x2100040080020080ull, 0x0800120400900148ull, 0x0010040a00128541ull,
+            0x2800804000800030ull, 0x1010002000400041ull, 0x4000200011004100ull, 0x0610008410800800ull,
+            0x0400802402800800ull, 0xc100020080800400ull, 0x0002000802000401ull, 0x0182085882000401ull,
+            0x0220204000808000ull, 0x2860100040024022ull, 0x0001002004110040ull, 0x99101042000a0020ull,
+            0x0004080004008080ull, 0x0010040002008080ull, 0x2012004881020004ull, 0x8300842444820011ull,
+            0x0088403882010200ull, 0x0820400080210100ull, 0x0110910040a00300ull, 0x0801100280080480ull,
+            0x0242009008200600ull, 0x1002000489500200ull, 0x0040800200010080ull, 0x0091800041000080ull,
+            0x0000209300488001ull, 0x04c1002414824001ull, 0x020020000b001041ull, 0x7000100004200901ull,
+            0x8002002004100802ull, 0x30010002084c0007ull, 0x0888221800813004ull, 0x4000002840840112ull
+    };
+
+    constexpr Magics bishop_magics = {
+            0xa010041108003100ull, 0x006082020a002900ull, 0x6810010619200000ull, 0x08281a0520000408ull,
+            0x0001104001000400ull, 0x0018901008048400ull, 0x00040a0210245280ull, 0x000200210808a402ull,
+            0x9140048410821200ull, 0x0800091010820041ull, 0x20504804832202c0ull, 0x0100091401081000ull,
+            0x8021011140000012ull, 0x0810020804450400ull, 0x208b0542109008a2ull, 0x0080084a08040204ull,
+            0x0040e2a80811244cull, 0x2505022008008108ull, 0x0430220100420040ull, 0x010a040420220040ull,
+            0x1105000290400000ull, 0x0093001200822120ull, 0x4000a62048043004ull, 0x280120048a015004ull,
+            0x006090002a020814ull, 0x44042000240800d0ull, 0x01102800040a4400ull, 0x1004080080220040ull,
+            0x0001001011004024ull, 0x0010044000805040ull, 0x0914041200820100ull, 0x0004821012821480ull,
+            0x0024040500c05021ull, 0x0088611002080200ull, 0x0116080a00040020ull, 0x4000020080080080ull,
+            0x2450450140840040ull, 0x0000880201484100ull, 0x0222020404020092ull, 0x8081110600002e00ull,
+            0x2842101105000801ull, 0x1100809008001025ull, 0x00020202221c0400ull, 0x0422014022009020ull,
+            0x0210046102100c00ull, 0xc004008082029102ull, 0x00aa461801101200ull, 0x0404080080201108ull,
+            0x020542108c205002ull, 0x0410544804100100ull, 0x0040910841100000ull, 0x0400200042021100ull,
+            0x00004204850400c0ull, 0x0200100410a42102ull, 0x1040020801210102ull, 0x0805040410420000ull,
+            0x2884804130100200ull, 0x800c262201242000ull, 0x1058000194108800ull, 0x0014221054420204ull,
+            0x0104000012a02200ull, 0x0200881003300100ull, 0x0140400202840100ull, 0x0402020801010201ull
+    };
+
+    // Sum over all squares of 2^(bits in mask).
+    constexpr std::size_t rook_table_size = 102400;
+    constexpr std::size_t bishop_table_size = 5248;
+
+    std::array<Bitboard, rook_table_size> rook_table;
+    std::array<Bitboard, bishop_table_size> bishop_table;
+
+    /**
+     * Walk each direction from the origin until the edge of the board or an occupied square, the slow way.
+     */
+    Bitboard walk_attacks(Loc origin, Bitboard occupied, Directions const& directions)
+    {
+        auto attacks = Bitboard{};
+
+        for (auto [dx, dy] : directions)
+        {
+            auto current = Loc::add_delta(origin, dx, dy);
+            while (current)
+            {
+                attacks |= chess::bit(*current);
+                if (chess::contains(occupied, *current))
+                {
+                    break;
+                }
+                current = Loc::add_delta(*current, dx, dy);
+            }
+        }
+
+        return attacks;
+    }
+
+    /**
+     * The squares whose occupancy affects the attacks from the origin. The last square in each direction never
+     * matters since the attack reaches it either way.
+     */
+    Bitboard relevant_mask(Loc origin, Directions const& directions)
+    {
+        auto mask = Bitboard{};
+
+        for (auto [dx, dy] : directions)
+        {
+            auto current = Loc::add_delta(origin, dx, dy);
+            while (current && Loc::add_delta(*current, dx, dy))
+            {
+                mask |= chess::bit(*current);
+                current = Loc::add_delta(*current, dx, dy);
+            }
+        }
+
+        return mask;
+    }
+
+    constexpr Bitboard file_a = 0x0101010101010101ull;
+    constexpr Bitboard file_h = file_a << (Loc::side_size - 1);
+
+    /**
+     * Squares attacked by all of a colour's pawns at once, by shifting them diagonally forward.
+     */
+    Bitboard pawns_attacks(Colour colour, Bitboard pawns)
+    {
+        if (colour == Colour::white)
+        {
+            return ((pawns & ~file_a) << 7) | ((pawns & ~file_h) << 9);
+        }
+        else
+        {
+            return ((pawns & ~file_a) >> 9) | ((pawns & ~file_h) >> 7);
+        }
+    }
+
+    std::array<SlidingLookup, Loc::board_size> build_lookup(Directions const& directions, Magics const& magics,
+                                                             Bitboard * table)
+    {
+        std::array<SlidingLookup, Loc::board_size> lookup = {};
+
+        for (int index = 0; index < Loc::board_size; ++index)
+        {
+            auto const origin = Loc{index};
+            auto const mask = relevant_mask(origin, directions);
+            auto const bits = static_cast<unsigned>(chess::popcount(mask));
+
+            lookup[index] = SlidingLookup{mask, magics[index], table, 64 - bits};
+
+            // Visit every subset of the mask with the Carry-Rippler trick.
+            auto occupied = Bitboard{};
+            do
+            {
+                auto attacks = walk_attacks(origin, occupied, directions);
+#if defined(__BMI2__)
+                table[_pext_u64(occupied, mask)] = attacks;
+#else
+                table[(occupied * magics[index]) >> (64 - bits)] = attacks;
+#endif
+                occupied = (occupied - mask) & mask;
+            }
+            while (occupied);
+
+            table += std::size_t{1} << bits;
+        }
+
+        return lookup;
+    }
+}
+
+std::array<SlidingLookup, Loc::board_size> const chess::detail::rook_lookup =
+        build_lookup(rook_directions, rook_magics, rook_table.data());
+
+std::array<SlidingLookup, Loc::board_size> const chess::detail::bishop_lookup =
+        build_lookup(bishop_directions, bishop_magics, bishop_table.data());
+
+Bitboard chess::attackers_to(Board const& board, Loc loc, Colour attacker, Bitboard occupied)
+{
+    auto const diagonal = board.pieces(SquareType::bishop) | board.pieces(SquareType::queen);
+    auto const straight = board.pieces(SquareType::rook) | board.pieces(SquareType::queen);
+
+    // A pawn attacks the square if a pawn of the other colour on the square would attack it.
+    auto const attackers = (knight_attacks(loc) & board.pieces(SquareType::knight))
+            | (king_attacks(loc) & board.pieces(SquareType::king))
+            | (pawn_attacks(flip_colour(attacker), loc) & board.pieces(SquareType::pawn))
+            | (bishop_attacks(loc, occupied) & diagonal)
+            | (rook_attacks(loc, occupied) & straight);
+
+    return attackers & board.pieces(attacker);
+}
+
+Bitboard chess::attackers_to(Board const& board, Loc loc, Colour attacker)
+{
+    return attackers_to(board, loc, attacker, board.occupied());
+}
+
+Bitboard chess::attacked_by(Board const& board, Colour attacker)
+{
+    auto const occupied = board.occupied();
+    auto attacked = pawns_attacks(attacker, board.pieces(attacker, SquareType::pawn));
+
+    for (auto loc : locs_of(board.pieces(attacker, SquareType::knight)))
+    {
+        attacked |= knight_attacks(loc);
+    }
+
+    for (auto loc : locs_of(board.pieces(attacker, SquareType::king)))
+    {
+        attacked |= king_attacks(loc);
+    }
+
+    auto const queens = board.pieces(attacker, SquareType::queen);
+
+    for (auto loc : locs_of(board.pieces(attacker, SquareType::bishop) | queens))
+    {
+        attacked |= bishop_attacks(loc, occupied);
+    }
+
+    for (auto loc : locs_of(board.pieces(attacker, SquareType::rook) | queens))
+    {
+        attacked |= rook_attacks(loc, occupied);
+    }
+
+    return attacked;
+}
+
+bool chess::in_check(Board const& board)
+{
+    auto const king = board.king(board.turn);
+    return king && attackers_to(board, *king, flip_colour(board.turn)) != 0;
+}
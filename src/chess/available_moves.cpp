@@ -1,5 +1,6 @@
 #include <chess/available_moves.h>
 #include <chess/Board.h>
+#include <chess/attacks.h>
 
 #include <algorithm>
 #include <vector>
@@ -8,40 +9,9 @@ namespace chess {
 
     namespace
     {
-        bool is_pawn_double_jump(Move const& move)
-        {
-            auto const& sq = move.result[move.dest];
-            auto const dy = move.src.y() - move.dest.y();
-
-            return (sq.type() == SquareType::pawn) && std::abs(dy) == 2;
-        }
-
-        std::optional<Loc> find_loc_of(Board const &b, Square sq)
-        {
-            for (auto const& loc : Loc::all_squares())
-            {
-                auto other = b[loc];
-                if (other == sq)
-                {
-                    return loc;
-                }
-            }
-
-            return std::nullopt;
-        }
-
         constexpr bool is_empty(Board const& board, Loc loc)
         {
-            return board[loc] == Empty();
-        }
-
-        /**
-         * Location would be a capture if moved there.
-         */
-        constexpr bool is_capturable(Board const& board, Loc src, Loc dest)
-        {
-            auto src_colour = board[src].colour();
-            return !is_empty(board, dest) && src_colour != board[dest].colour();
+            return !contains(board.occupied(), loc);
         }
 
         /**
@@ -53,165 +23,261 @@ namespace chess {
             return p.type() != SquareType::empty && p.has_moved();
         }
 
-        struct FullTracker
+        /**
+         * What a move by the player whose turn it is must respect to not leave their own king in check. Working this
+         * out once per position lets illegal moves be skipped as they are generated, rather than making every move
+         * and looking for check afterwards.
+         */
+        struct Restrictions
         {
-            FullTracker(Board const& start) : start{start} {}
-
-            std::vector<Move> pilfer()
+            static Restrictions legal(Board const& board)
             {
-                std::vector<Move> receiver;
-                std::swap(receiver, moves);
-                return receiver;
+                auto restrictions = Restrictions{};
+
+                auto const us = board.turn;
+                auto const them = flip_colour(us);
+                auto const our_king = board.king(us);
+
+                // Without a king there is nothing to protect.
+                if (!our_king)
+                {
+                    return restrictions;
+                }
+
+                auto const king = *our_king;
+                auto const occupied = board.occupied();
+                restrictions.king = king;
+                restrictions.checkers = attackers_to(board, king, them, occupied);
+
+                switch (popcount(restrictions.checkers))
+                {
+                    case 0:
+                        break;
+                    case 1:
+                        // Capture the checker or block it.
+                        restrictions.check_mask = restrictions.checkers | between(king, lsb(restrictions.checkers));
+                        break;
+                    default:
+                        // Only the king moving can get out of double check.
+                        restrictions.check_mask = 0;
+                        break;
+                }
+
+                // A piece is pinned if it is the only thing between the king and an enemy slider.
+                auto const diagonal = board.pieces(SquareType::bishop) | board.pieces(SquareType::queen);
+                auto const straight = board.pieces(SquareType::rook) | board.pieces(SquareType::queen);
+                auto const snipers = board.pieces(them)
+                        & ((bishop_attacks(king, 0) & diagonal) | (rook_attacks(king, 0) & straight));
+
+                for (auto sniper : locs_of(snipers))
+                {
+                    auto const blockers = between(king, sniper) & occupied;
+                    if (popcount(blockers) == 1)
+                    {
+                        restrictions.pinned |= blockers & board.pieces(us);
+                    }
+                }
+
+                return restrictions;
             }
 
+            std::optional<Loc> king = std::nullopt;
+            Bitboard checkers = 0;
+
+            /**
+             * Where a piece other than the king has to move. Anywhere when not in check, onto the checker or between
+             * it and the king when in check, and nowhere in double check.
+             */
+            Bitboard check_mask = ~Bitboard{0};
+
+            /**
+             * Pieces that may only move along the line between them and their king.
+             */
+            Bitboard pinned = 0;
+        };
+
+        /**
+         * Records each move as a Ply, leaving it to the caller to make it on a board if it needs the result.
+         */
+        struct PlyTracker
+        {
+            explicit PlyTracker(MoveList & plies) : plies{plies} {}
+
             void add(Loc src, Loc dest)
             {
-                Board b = start;
-                b.last_turn_pawn_double_jump_dest = std::nullopt;
-                b.turn = flip_colour(b.turn);
-                b[dest] = b[src];
-                b[src] = Empty();
-                b[dest].set_moved();
-                moves.push_back({src, dest, b});
+                plies.push_back({src, dest});
             }
 
-            void add_castling(Loc king_src, Loc king_dest, Loc rook_src, Loc rook_dest)
+            void add_castling(Loc king_src, Loc king_dest, Loc /*rook_src*/, Loc /*rook_dest*/)
             {
-                Board b = start;
-                b.last_turn_pawn_double_jump_dest = std::nullopt;
-                b.turn = flip_colour(b.turn);
-                b[king_dest] = b[king_src];
-                b[king_src] = Empty();
-                b[rook_dest] = b[rook_src];
-                b[rook_src] = Empty();
-
-                b[rook_dest].set_moved();
-                b[king_dest].set_moved();
-
-                moves.push_back({king_src, king_dest, b});
+                plies.push_back({king_src, king_dest, PlyKind::castling});
             }
 
             void add_pawn_double_jump(Loc src, Loc dest)
             {
-                Board b = start;
-                b.turn = flip_colour(b.turn);
-                b.last_turn_pawn_double_jump_dest = dest;
-                b[dest] = b[src];
-                b[src] = Empty();
-                b[dest].set_moved();
-                moves.push_back({src, dest, b});
+                plies.push_back({src, dest, PlyKind::pawn_double_jump});
             }
 
-            void add_en_passant(Loc src, Loc dest, Loc last_turn_double_jump_dest)
+            void add_en_passant(Loc src, Loc dest, Loc /*last_turn_double_jump_dest*/)
             {
-                Board b = start;
-                b.last_turn_pawn_double_jump_dest = std::nullopt;
-                b.turn = flip_colour(b.turn);
-                b[dest] = b[src];
-                b[src] = Empty();
-                b[last_turn_double_jump_dest] = Empty(); // capture en passant
-                b[dest].set_moved();
-
-                moves.push_back({src, dest, b});
+                plies.push_back({src, dest, PlyKind::en_passant});
             }
 
             void add_promotions(Loc src, Loc dest)
             {
-                auto new_board = start;
-                new_board.turn = flip_colour(new_board.turn);
-                new_board.last_turn_pawn_double_jump_dest = std::nullopt;
-                new_board[dest] = new_board[src];
-                new_board[src] = Empty();
+                plies.push_back({src, dest, PlyKind::promotion, SquareType::rook});
+                plies.push_back({src, dest, PlyKind::promotion, SquareType::bishop});
+                plies.push_back({src, dest, PlyKind::promotion, SquareType::knight});
+                plies.push_back({src, dest, PlyKind::promotion, SquareType::queen});
+            }
 
-                new_board[dest].set_type(SquareType::rook);
-                moves.push_back({src, dest, new_board, MoveType::normal, true});
+            static constexpr bool satisfied() { return false; }
 
-                new_board[dest].set_type(SquareType::bishop);
-                moves.push_back({src, dest, new_board, MoveType::normal, true});
+            MoveList & plies;
+        };
 
-                new_board[dest].set_type(SquareType::knight);
-                moves.push_back({src, dest, new_board, MoveType::normal, true});
+        /**
+         * Only notes whether there is any move at all, so generation can stop at the first one.
+         */
+        struct AnyPlyTracker
+        {
+            void add(Loc, Loc) { found = true; }
+            void add_castling(Loc, Loc, Loc, Loc) { found = true; }
+            void add_pawn_double_jump(Loc, Loc) { found = true; }
+            void add_en_passant(Loc, Loc, Loc) { found = true; }
+            void add_promotions(Loc, Loc) { found = true; }
 
-                new_board[dest].set_type(SquareType::queen);
-                moves.push_back({src, dest, new_board, MoveType::normal, true});
-            }
+            bool satisfied() const { return found; }
 
-        private:
-            Board const& start;
-            std::vector<Move> moves;
+            bool found = false;
         };
 
-        template<typename Tracker>
+        /**
+         * Generates the plies for the player whose turn it is, which is fixed at compile time so that pawn directions
+         * and promotion ranks are constants rather than branches.
+         */
+        template<Colour us, typename Tracker>
         struct PotentialMoves
         {
-            explicit PotentialMoves(Board const& board, Tracker & tracker);
+            PotentialMoves(Board const& board, Tracker & tracker, Restrictions restrictions,
+                           PlyStage stage = PlyStage::all, Bitboard sources = ~Bitboard{0});
 
         private:
+            static constexpr Colour them = flip_colour(us);
+
+            /**
+             * Which way our pawns move up the board.
+             */
+            static constexpr int forward = us == Colour::white ? 1 : -1;
+
+            static constexpr int promotion_y = us == Colour::white ? Loc::side_size - 1 : 0;
+
+            /**
+             * Location holds an opponent's piece, so would be a capture if moved there.
+             */
+            bool is_capture(Loc dest) const
+            {
+                return contains(board.pieces(them), dest);
+            }
+
             void generate_for(Square, Loc);
-            void generate_for_pawn(Square, Loc);
+            void generate_for_pawn(Loc);
             void generate_for_rook(Loc);
             void generate_for_knight(Loc);
             void generate_for_bishop(Loc);
             void generate_for_queen(Loc);
-            void generate_for_king(Square, Loc);
+            void generate_for_king(Loc);
 
-            void generate_en_passant(Square, Loc);
-            void generate_promotions(Square, Loc);
+            void generate_en_passant(Loc);
+            void generate_promotions(Loc);
 
             /**
-             * Add a standard move or capture move, return if should stop.
+             * Set ability to move to given offset-location only if it would be a capture.
              */
-            bool add_standard(Loc src, Loc dest);
+            void add_delta_capture(int dx, int dy, Loc src);
 
             /**
-             * Set ability to move to given offset-location. Allows move to empty square and to capture.
+             * Add ability to move to given offset-location only if it is empty
              */
-            void add_delta(int dx, int dy, Loc src);
+            void add_delta_empty(int dx, int dy, Loc src);
+
+            void add_pawn_double_jump(int dx, int dy, Loc src);
 
             /**
-             * Set ability to move to given offset-location only if it would be a capture.
+             * Add a move to each of the targets that is empty or holds an opponent's piece.
              */
-            void add_delta_capture(int dx, int dy, Loc src);
+            void add_targets(Loc src, Bitboard targets);
 
             /**
-             * Add ability to move to given offset-location only if it is empty
+             * Of the targets for a piece other than the king, those that would not leave the king in check.
              */
-            void add_delta_empty(int dx, int dy, Loc src);
+            Bitboard legal_targets(Loc src, Bitboard targets) const;
 
-            void add_pawn_double_jump(int dx, int dy, Loc src);
+            bool is_legal(Loc src, Loc dest) const;
 
             /**
-             * Add moves for the given direction from the source square.
+             * The king would not be in check on this square once it has moved off its current one.
              */
-            void add_direction(Sign x, Sign y, Loc src);
+            bool is_safe_for_king(Loc dest) const;
+
+            /**
+             * En passant removes two pawns from a rank at once, so can expose the king in ways a pin does not show.
+             */
+            bool is_legal_en_passant(Loc src, Loc dest, Loc captured) const;
+
+            bool wants_captures() const { return stage != PlyStage::quiets; }
+            bool wants_quiets() const { return stage != PlyStage::captures; }
 
             Board const& board;
             Tracker & tracker;
+            Restrictions restrictions;
+            PlyStage stage;
+
+            /**
+             * Squares a normal move may land on for the stage: the opponent's pieces, empty squares, or both.
+             */
+            Bitboard destinations;
         };
 
-        template<typename Tracker>
-        PotentialMoves<Tracker>::PotentialMoves(Board const& board, Tracker & tracker)
-                : board{board}, tracker{tracker}
+        template<Colour us, typename Tracker>
+        PotentialMoves<us, Tracker>::PotentialMoves(Board const& board, Tracker & tracker, Restrictions restrictions,
+                                                PlyStage stage, Bitboard sources)
+                : board{board}, tracker{tracker}, restrictions{restrictions}, stage{stage}, destinations{}
         {
-            auto current_colour = board.turn;
+            if (wants_captures())
+            {
+                destinations |= board.pieces(them);
+            }
 
-            for (Loc loc : Loc::all_squares())
+            if (wants_quiets())
             {
-                auto sq = board[loc];
-                if (sq.colour() == current_colour)
+                destinations |= ~board.occupied();
+            }
+
+            // Only the king moving can get out of double check.
+            auto const movers = restrictions.check_mask == 0
+                    ? board.pieces(us, SquareType::king)
+                    : board.pieces(us);
+
+            for (Loc loc : locs_of(movers & sources))
+            {
+                // Trackers that only need some of the moves can stop us early.
+                if (tracker.satisfied())
                 {
-                    generate_for(sq, loc);
+                    return;
                 }
+
+                generate_for(board[loc], loc);
             }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for(Square sq, Loc src)
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for(Square sq, Loc src)
         {
             switch (sq.type())
             {
                 case SquareType::pawn:
-                    generate_for_pawn(sq, src);
+                    generate_for_pawn(src);
                     break;
                 case SquareType::bishop:
                     generate_for_bishop(src);
@@ -226,216 +292,222 @@ namespace chess {
                     generate_for_queen(src);
                     break;
                 case SquareType::king:
-                    generate_for_king(sq, src);
+                    generate_for_king(src);
                     break;
                 case SquareType::empty:
                     break;
             }
         }
 
-        template<typename Tracker>
-        bool PotentialMoves<Tracker>::add_standard(Loc src, Loc dest)
-        {
-            bool empty = is_empty(board, dest);
-            bool capture = is_capturable(board, src, dest);
-            bool occupied = capture || !empty;
-
-            if (empty || capture)
-            {
-                tracker.add(src, dest);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::add_delta_capture(int dx, int dy, Loc src) {
+            auto dest = detail::step(src, dx, dy);
+            if (dest && is_capture(*dest) && is_legal(src, *dest)) {
+                tracker.add(src, *dest);
             }
-
-            return occupied;
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::add_delta(int dx, int dy, Loc src) {
-            auto dest = Loc::add_delta(src, dx, dy);
-            if (dest && (is_empty(board, *dest) || is_capturable(board, src, *dest))) {
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::add_delta_empty(int dx, int dy, Loc src) {
+            auto dest = detail::step(src, dx, dy);
+            if (dest && is_empty(board, *dest) && is_legal(src, *dest)) {
                 tracker.add(src, *dest);
             }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::add_delta_capture(int dx, int dy, Loc src) {
-            auto dest = Loc::add_delta(src, dx, dy);
-            if (dest && is_capturable(board, src, *dest)) {
-                tracker.add(src, *dest);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::add_pawn_double_jump(int dx, int dy, Loc src) {
+            auto dest = detail::step(src, dx, dy);
+            if (dest && is_empty(board, *dest) && is_legal(src, *dest)) {
+                tracker.add_pawn_double_jump(src, *dest);
             }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::add_delta_empty(int dx, int dy, Loc src) {
-            auto dest = Loc::add_delta(src, dx, dy);
-            if (dest && is_empty(board, *dest)) {
-                tracker.add(src, *dest);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::add_targets(Loc src, Bitboard targets) {
+            for (Loc dest : locs_of(legal_targets(src, targets & destinations))) {
+                tracker.add(src, dest);
             }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::add_pawn_double_jump(int dx, int dy, Loc src) {
-            auto dest = Loc::add_delta(src, dx, dy);
-            if (dest && is_empty(board, *dest)) {
-                tracker.add_pawn_double_jump(src, *dest);
+        template<Colour us, typename Tracker>
+        Bitboard PotentialMoves<us, Tracker>::legal_targets(Loc src, Bitboard targets) const
+        {
+            targets &= restrictions.check_mask;
+
+            if (contains(restrictions.pinned, src))
+            {
+                targets &= line(*restrictions.king, src);
             }
+
+            return targets;
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::add_direction(Sign x, Sign y, Loc src) {
-            for (Loc loc : Loc::direction(src, x, y)) {
-                if (add_standard(src, loc)) {
-                    break;
-                }
-            }
+        template<Colour us, typename Tracker>
+        bool PotentialMoves<us, Tracker>::is_legal(Loc src, Loc dest) const
+        {
+            return legal_targets(src, bit(dest)) != 0;
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for_pawn(Square p, Loc src) {
-            int direction = p.colour() == Colour::white ? 1 : -1;
+        template<Colour us, typename Tracker>
+        bool PotentialMoves<us, Tracker>::is_safe_for_king(Loc dest) const
+        {
+            // Take the king off the board so that sliders attacking it are seen to carry on past it.
+            auto const occupied = board.occupied() & ~bit(*restrictions.king);
+            return attackers_to(board, dest, them, occupied) == 0;
+        }
 
+        template<Colour us, typename Tracker>
+        bool PotentialMoves<us, Tracker>::is_legal_en_passant(Loc src, Loc dest, Loc captured) const
+        {
+            if (!restrictions.king)
+            {
+                return true;
+            }
+
+            auto const occupied = (board.occupied() & ~bit(src) & ~bit(captured)) | bit(dest);
+            auto const attackers = attackers_to(board, *restrictions.king, them, occupied);
+            return (attackers & ~bit(captured)) == 0;
+        }
+
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for_pawn(Loc src) {
             // Only add square ahead if not at the end of the board. Promotion move dealt with specially.
-            if (auto dest = Loc::add_delta(src, 0, direction); dest && (dest->y() != Loc::side_size - 1 && dest->y() != 0))
+            if (auto dest = detail::step(src, 0, forward); dest && dest->y() != promotion_y)
             {
-                add_delta_empty(0, direction, src);
-                add_delta_capture(1, direction, src);
-                add_delta_capture(-1, direction, src);
+                if (wants_quiets())
+                {
+                    add_delta_empty(0, forward, src);
+                }
+
+                if (wants_captures())
+                {
+                    add_delta_capture(1, forward, src);
+                    add_delta_capture(-1, forward, src);
+                }
             }
 
             // Can move two if hasn't moved before and first space free.
-            auto jump_one = Loc::add_delta(src, 0, direction);
-            if (jump_one && is_empty(board, *jump_one) && !has_moved(board, src)) {
-                add_pawn_double_jump(0, 2 * direction, src);
+            auto jump_one = detail::step(src, 0, forward);
+            if (wants_quiets() && jump_one && is_empty(board, *jump_one) && !has_moved(board, src)) {
+                add_pawn_double_jump(0, 2 * forward, src);
             }
 
-            generate_en_passant(p, src);
-            generate_promotions(p, src);
+            // Even a promotion that captures nothing wins material, so all promotions go with the captures.
+            if (wants_captures())
+            {
+                generate_en_passant(src);
+                generate_promotions(src);
+            }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_promotions(Square p, Loc src)
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_promotions(Loc src)
         {
-            int direction = p.colour() == Colour::white ? 1 : -1;
-            auto non_capture_dest = Loc::add_delta(src, 0, direction);
-            auto left_capture_dest = Loc::add_delta(src, -1, direction);
-            auto right_capture_dest = Loc::add_delta(src, 1, direction);
+            auto non_capture_dest = detail::step(src, 0, forward);
+            auto left_capture_dest = detail::step(src, -1, forward);
+            auto right_capture_dest = detail::step(src, 1, forward);
 
-            // Must be a promotion if we're going to land on either end of the board.
-            if (non_capture_dest && (non_capture_dest->y() == Loc::side_size - 1 || non_capture_dest->y() == 0))
+            // Must be a promotion if we're going to land on the far end of the board.
+            if (non_capture_dest && non_capture_dest->y() == promotion_y)
             {
-                if (is_empty(board, *non_capture_dest))
+                if (is_empty(board, *non_capture_dest) && is_legal(src, *non_capture_dest))
                 {
                     tracker.add_promotions(src, *non_capture_dest);
                 }
 
-                if (left_capture_dest && is_capturable(board, src, *left_capture_dest))
+                if (left_capture_dest && is_capture(*left_capture_dest) && is_legal(src, *left_capture_dest))
                 {
                     tracker.add_promotions(src, *left_capture_dest);
 
                 }
 
-                if (right_capture_dest && is_capturable(board, src, *right_capture_dest))
+                if (right_capture_dest && is_capture(*right_capture_dest) && is_legal(src, *right_capture_dest))
                 {
                     tracker.add_promotions(src, *right_capture_dest);
                 }
             }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_en_passant(Square p, Loc src)
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_en_passant(Loc src)
         {
             // If in the last move a pawn jumped 2 spaces, and we're in the position where if it moved just one we could
             // take it, we can move there and take the pawn that jumped 2 squares.
 
-            int direction = p.colour() == Colour::white ? 1 : -1;
-            auto const& current_board = board;
-
             if (auto const& last_move_dest = board.last_turn_pawn_double_jump_dest; last_move_dest)
             {
                 bool last_move_was_to_side_of_current =
                         src.y() == last_move_dest->y() && std::abs(src.x() - last_move_dest->x()) == 1;
 
                 if (last_move_was_to_side_of_current) {
-                    auto dest = Loc::add_delta(*last_move_dest, 0, direction);
-                    if (dest && is_empty(board, *dest)) {
-                        tracker.add_en_passant(src, *dest, *board.last_turn_pawn_double_jump_dest);
+                    auto dest = detail::step(*last_move_dest, 0, forward);
+                    if (dest && is_empty(board, *dest) && is_legal_en_passant(src, *dest, *last_move_dest)) {
+                        tracker.add_en_passant(src, *dest, *last_move_dest);
                     }
                 }
             }
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for_rook(Loc src) {
-            add_direction(Sign::positive , Sign::none , src);
-            add_direction(Sign::none , Sign::positive , src);
-            add_direction(Sign::none , Sign::negative , src);
-            add_direction(Sign::negative , Sign::none , src);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for_rook(Loc src) {
+            add_targets(src, rook_attacks(src, board.occupied()));
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for_knight(Loc src) {
-            add_delta(1, 2, src);
-            add_delta(1, -2, src);
-            add_delta(-1, 2, src);
-            add_delta(-1, -2, src);
-            add_delta(2, 1, src);
-            add_delta(2, -1, src);
-            add_delta(-2, 1, src);
-            add_delta(-2, -1, src);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for_knight(Loc src) {
+            add_targets(src, knight_attacks(src));
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for_bishop(Loc src) {
-            add_direction(Sign::positive , Sign::positive , src);
-            add_direction(Sign::negative , Sign::positive , src);
-            add_direction(Sign::positive , Sign::negative , src);
-            add_direction(Sign::negative , Sign::negative , src);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for_bishop(Loc src) {
+            add_targets(src, bishop_attacks(src, board.occupied()));
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for_queen(Loc src) {
-            add_direction(Sign::none , Sign::positive , src);
-            add_direction(Sign::positive , Sign::none , src);
-            add_direction(Sign::negative , Sign::none , src);
-            add_direction(Sign::none , Sign::negative , src);
-            add_direction(Sign::positive , Sign::positive , src);
-            add_direction(Sign::negative , Sign::positive , src);
-            add_direction(Sign::positive , Sign::negative , src);
-            add_direction(Sign::negative , Sign::negative , src);
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for_queen(Loc src) {
+            add_targets(src, queen_attacks(src, board.occupied()));
         }
 
-        template<typename Tracker>
-        void PotentialMoves<Tracker>::generate_for_king(Square k, Loc src) {
-            add_delta(0, 1, src);
-            add_delta(1, 1, src);
-            add_delta(1, 0, src);
-            add_delta(1, -1, src);
-            add_delta(0, -1, src);
-            add_delta(-1, -1, src);
-            add_delta(-1, 0, src);
-            add_delta(-1, 1, src);
-
-            auto empty_from_to = [this](Loc from_exclusive, Loc to_inclusive)
+        template<Colour us, typename Tracker>
+        void PotentialMoves<us, Tracker>::generate_for_king(Loc src) {
+            for (Loc dest : locs_of(king_attacks(src) & destinations))
             {
-                auto check_direction = from_exclusive.x() > to_inclusive.x() ? -1 : 1;
-                auto y = from_exclusive.y();
-                auto [x_min, x_max] = std::minmax({from_exclusive.x() + check_direction, to_inclusive.x()});
+                if (is_safe_for_king(dest))
+                {
+                    tracker.add(src, dest);
+                }
+            }
 
-                for (auto x = x_min; x <= x_max; ++x)
+            if (!wants_quiets())
+            {
+                return;
+            }
+
+            // Everything between the king and the rook has to be clear, including the b-file square the king never
+            // crosses when castling queenside.
+            auto clear_to_rook = [this](Loc king, Loc rook)
+            {
+                return (between(king, rook) & board.occupied()) == 0;
+            };
+
+            // Can't castle out of check, or through or into an attacked square. Only worth working out which squares
+            // are attacked once some castling is otherwise possible.
+            auto attacked = std::optional<Bitboard>{};
+            auto safe_from_to = [this, &attacked](Loc from, Loc to)
+            {
+                if (!attacked)
                 {
-                    if (!is_empty(board, {x, y}))
-                    {
-                        return false;
-                    }
+                    attacked = attacked_by(board, them);
                 }
-                return true;
+                return ((between(from, to) | bit(from) | bit(to)) & *attacked) == 0;
             };
 
             if (!has_moved(board, src))
             {
-                auto colour = k.colour();
                 auto left = Loc{0, src.y()};
                 auto right = Loc{Loc::side_size - 1, src.y()};
-                auto rook = Rook(colour);
+                auto rook = Rook(us);
 
                 if (board[left] == rook && !has_moved(board, left))
                 {
@@ -443,7 +515,7 @@ namespace chess {
                     auto king_dest = *Loc::add_delta(left, 2, 0);
                     auto rook_dest = *Loc::add_delta(left, 3, 0);
 
-                    if (empty_from_to(king_src, king_dest))
+                    if (clear_to_rook(king_src, left) && safe_from_to(king_src, king_dest))
                     {
                         tracker.add_castling(king_src, king_dest, left, rook_dest);
                     }
@@ -455,7 +527,7 @@ namespace chess {
                     auto king_dest = *Loc::add_delta(right, -1, 0);
                     auto rook_dest = *Loc::add_delta(right, -2, 0);
 
-                    if (empty_from_to(king_src, king_dest))
+                    if (clear_to_rook(king_src, right) && safe_from_to(king_src, king_dest))
                     {
                         tracker.add_castling(king_src, king_dest, right, rook_dest);
                     }
@@ -463,168 +535,138 @@ namespace chess {
             }
         }
 
-        std::vector<Move> potential_moves(Board const& board)
-        {
-            auto tracker = FullTracker{board};
-            PotentialMoves<FullTracker>{board, tracker};
-            return tracker.pilfer();
-        }
-
-        struct BoardMask
-        {
-                void set(Loc loc)
-                {
-                    auto mask = std::uint64_t{1u} << static_cast<std::uint64_t >(loc.index());
-                    m_data |= mask;
-                }
-
-                bool get(Loc loc) const
-                {
-                    auto mask = std::uint64_t{1u} << static_cast<std::uint64_t >(loc.index());
-                    return mask & m_data;
-                }
-        private:
-                std::uint64_t m_data;
-        };
-
-        struct ThreatTracker
+        /**
+         * Run the generator specialised for whoever's turn it is.
+         */
+        template<typename Tracker>
+        void generate(Board const& board, Tracker & tracker, Restrictions restrictions,
+                      PlyStage stage = PlyStage::all, Bitboard sources = ~Bitboard{0})
         {
-            void add(Loc src, Loc dest)
+            if (board.turn == Colour::white)
             {
-                threatened.set(dest);
+                PotentialMoves<Colour::white, Tracker>{board, tracker, restrictions, stage, sources};
             }
-
-            void add_en_passant(Loc src, Loc dest, Loc last_turn_double_jump_dest)
-            {
-                threatened.set(dest);
-            }
-
-            void add_promotions(Loc src, Loc dest)
+            else
             {
-                // TODO: Add unit test that fails if this line isn't present.
-                threatened.set(dest);
+                PotentialMoves<Colour::black, Tracker>{board, tracker, restrictions, stage, sources};
             }
-
-            void add_castling(Loc king_src, Loc king_dest, Loc rook_src, Loc rook_dest) {}
-            void add_pawn_double_jump(Loc src, Loc dest) {}
-
-            BoardMask threatened;
-        };
-
-        BoardMask generate_threat_board(Board const& board)
-        {
-            auto tracker = ThreatTracker{};
-            PotentialMoves<ThreatTracker>{board, tracker};
-            return tracker.threatened;
         }
 
-        bool is_castling(Move const& move)
+        /**
+         * Legal plies for the player whose turn it is.
+         */
+        void legal_plies(Board const& board, MoveList & plies, PlyStage stage = PlyStage::all)
         {
-            return (move.result[move.dest].type() == SquareType::king) && std::abs(move.src.x() - move.dest.x()) > 1;
+            plies.clear();
+            auto tracker = PlyTracker{plies};
+            generate(board, tracker, Restrictions::legal(board), stage);
         }
 
-        bool causes_mover_to_be_in_check(Board board, Move const& current_move)
+        /**
+         * Whether the player to move on the board is in check, and if so whether they have any way out of it.
+         */
+        MoveType classify_position(Board const& board)
         {
-            // Must do before assuming the move.
-            auto current_colour = board.turn;
-            board = current_move.result;
+            if (!in_check(board))
+            {
+                return MoveType::normal;
+            }
 
-            auto king_loc = find_loc_of(board, King(current_colour));
-            auto threatened = generate_threat_board(board);
+            // It is checkmate if there is no move that gets them out of check.
+            return has_legal_move(board) ? MoveType::check : MoveType::checkmate;
+        }
+    }
 
-            bool in_check = king_loc && threatened.get(*king_loc);
+    bool has_legal_move(Board const& board)
+    {
+        auto tracker = AnyPlyTracker{};
+        generate(board, tracker, Restrictions::legal(board));
+        return tracker.found;
+    }
 
-            if (!in_check && is_castling(current_move))
-            {
-                // Determine squares that need to be checked.
-                auto vulnerable_squares = std::vector<Loc>{};
-                auto y = current_move.src.y();
-                auto x1 = current_move.src.x();
-                auto x2 = current_move.dest.x();
-                auto [x_begin, x_end] = std::minmax({x1, x2});
-
-                for (auto x = x_begin; x <= x_end; ++x)
-                {
-                    vulnerable_squares.emplace_back(x,y);
-                }
+    void available_plies(Board const& board, MoveList & plies)
+    {
+        legal_plies(board, plies);
+    }
 
-                in_check |= std::any_of(begin(vulnerable_squares), end(vulnerable_squares), [&threatened](Loc loc)
-                {
-                    return threatened.get(loc);
-                });
-            }
+    void available_plies(Board const& board, MoveList & plies, PlyStage stage)
+    {
+        legal_plies(board, plies, stage);
+    }
 
-            return in_check;
-        }
+    std::vector<Ply> available_captures(Board const& board)
+    {
+        auto plies = MoveList{};
+        legal_plies(board, plies, PlyStage::captures);
+        return {plies.begin(), plies.end()};
+    }
 
-        MoveType determine_if_causes_check(Board board, Move const& current_move)
+    void available_captures(Board const& board, MoveList & plies)
+    {
+        legal_plies(board, plies, PlyStage::captures);
+    }
+
+    bool is_legal(Board const& board, Ply ply)
+    {
+        if (!contains(board.pieces(board.turn), ply.src()))
         {
-            // Must do before assuming the move.
-            auto opposite_colour = (board.turn == Colour::white) ? Colour::black : Colour::white;
-            board = current_move.result; // make the move
-            board.turn = flip_colour(board.turn);
+            return false;
+        }
 
-            auto king_loc = find_loc_of(board, King(opposite_colour));
-            auto threatened = generate_threat_board(board);
-            bool in_check = king_loc && threatened.get(*king_loc);
+        // Only the moving piece's plies need generating to know whether this is one of them.
+        auto plies = MoveList{};
+        auto tracker = PlyTracker{plies};
+        generate(board, tracker, Restrictions::legal(board), PlyStage::all, bit(ply.src()));
 
-            return in_check ? MoveType::check : MoveType::normal;
-        }
+        return std::find(plies.begin(), plies.end(), ply) != plies.end();
+    }
 
+    std::vector<Ply> available_plies(Board const& board)
+    {
+        auto plies = MoveList{};
+        legal_plies(board, plies);
+        return {plies.begin(), plies.end()};
+    }
 
-        MoveType determine_if_causes_checkmate(Board board, Move const& current_move)
-        {
-            // We know that the move given causes check for the other player
-            // We want to determine if it is checkmate.
-            // ie, if I make the move, the other player cannot play another move that gets them out of check.
+    MoveType classify(Board const& board, Ply ply)
+    {
+        auto after = board;
+        after.make(ply);
+        return classify_position(after);
+    }
 
-            board = current_move.result; // make the move that causes check.
-            auto potentials = potential_moves(board); // get moves for other player
+    MoveType classify(Move const& move)
+    {
+        return classify_position(move.result);
+    }
 
-            // Filter out moves that put the enemy in check.
-            auto it = std::remove_if(begin(potentials), end(potentials), [&board](Move const& move)
-            {
-                return causes_mover_to_be_in_check(board, move);
-            });
-            potentials.erase(it, end(potentials));
+    Move to_move(Board const& board, Ply ply, Classification classification)
+    {
+        auto move = Move{ply.src(), ply.dest(), board, MoveType::unclassified, ply.kind() == PlyKind::promotion};
+        move.result.make(ply);
 
-            if (potentials.empty())
-            {
-                return MoveType::checkmate;
-            }
-            else
-            {
-                return MoveType::check;
-            }
+        if (classification == Classification::eager)
+        {
+            move.type = classify_position(move.result);
         }
+
+        return move;
     }
 
-    std::vector<Move> available_moves(Board const& board)
+    std::vector<Move> available_moves(Board const& board, Classification classification)
     {
-        auto potentials = potential_moves(board);
+        auto plies = MoveList{};
+        legal_plies(board, plies);
 
-        auto it = std::remove_if(begin(potentials), end(potentials), [&board](Move const& move)
-        {
-            return causes_mover_to_be_in_check(board, move);
-        });
-        potentials.erase(it, end(potentials));
-
-        // For each potential move, skip next player, see if current player could take king on next go
-        // ie the move causes check.
-        std::for_each(begin(potentials), end(potentials), [&board](Move & move) {
-            move.type = determine_if_causes_check(board, move);
-        });
-
-        // Want to check for checkmate for each move that causes check.
-        std::for_each(begin(potentials), end(potentials), [&board](Move & move)
+        auto moves = std::vector<Move>{};
+        moves.reserve(plies.size());
+
+        // Only the moves that survive get a board of their own.
+        for (auto ply : plies)
         {
-            if (move.type == MoveType::check)
-            {
-                move.type = determine_if_causes_checkmate(board, move);
-            }
-        });
+            moves.push_back(to_move(board, ply, classification));
+        }
 
-        return potentials;
+        return moves;
     }
-
-}
\ No newline at end of file
+}
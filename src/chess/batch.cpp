@@ -0,0 +1,40 @@
+#include <chess/batch.h>
+#include <chess/available_moves.h>
+
+using chess::Board;
+using chess::MoveList;
+using chess::Ply;
+
+std::vector<std::vector<Ply>> chess::available_plies(std::vector<Board> const& boards, perf::ThreadPool & pool)
+{
+    auto result = std::vector<std::vector<Ply>>(boards.size());
+
+    pool.for_each_chunk(boards.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+        auto plies = MoveList{};
+        for (auto i = begin; i < end; ++i)
+        {
+            available_plies(boards[i], plies);
+            result[i].assign(plies.begin(), plies.end());
+        }
+    });
+
+    return result;
+}
+
+std::vector<std::size_t> chess::count_plies(std::vector<Board> const& boards, perf::ThreadPool & pool)
+{
+    auto result = std::vector<std::size_t>(boards.size());
+
+    pool.for_each_chunk(boards.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+    {
+        auto plies = MoveList{};
+        for (auto i = begin; i < end; ++i)
+        {
+            available_plies(boards[i], plies);
+            result[i] = plies.size();
+        }
+    });
+
+    return result;
+}
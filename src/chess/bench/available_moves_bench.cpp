@@ -3,6 +3,7 @@
 
 #include <chess/pgn/MoveParser.h>
 #include <chess/pgn/resolve_move.h>
+#include <chess/text/fen.h>
 
 #include <benchmark/benchmark.h>
 
@@ -37,6 +38,39 @@ namespace
         }
     }
 
+    void bench_available_moves_standard_board_lazy(benchmark::State& state)
+    {
+        auto board = Board::standard();
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(available_moves(board, chess::Classification::lazy));
+        }
+    }
+
+    void bench_available_captures_middlegame(benchmark::State& state)
+    {
+        auto board = chess::text::from_fen("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10");
+        auto captures = chess::MoveList{};
+
+        for (auto _ : state)
+        {
+            chess::available_captures(board, captures);
+            benchmark::DoNotOptimize(captures);
+        }
+    }
+
+    void bench_available_plies_middlegame(benchmark::State& state)
+    {
+        auto board = chess::text::from_fen("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10");
+        auto plies = chess::MoveList{};
+
+        for (auto _ : state)
+        {
+            chess::available_plies(board, plies);
+            benchmark::DoNotOptimize(plies);
+        }
+    }
+
     void bench_available_moves_for_some_pgn(benchmark::State& state)
     {
         auto stream = std::istringstream{R"(
@@ -89,5 +123,8 @@ namespace
 
 BENCHMARK(bench_available_moves_one_pawn)->Unit(benchmark::kMicrosecond);
 BENCHMARK(bench_available_moves_standard_board)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bench_available_moves_standard_board_lazy)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bench_available_captures_middlegame)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bench_available_plies_middlegame)->Unit(benchmark::kMicrosecond);
 BENCHMARK(bench_available_moves_for_some_pgn)->Unit(benchmark::kMicrosecond);
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <chess/Board.h>
+#include <chess/perft.h>
+#include <chess/text/fen.h>
+
+#include <benchmark/benchmark.h>
+
+using chess::text::from_fen;
+
+namespace
+{
+    // Positions and depths from the Chess Programming Wiki's perft results, picked to exercise castling, en passant,
+    // promotions and pins.
+    auto constexpr kiwipete_fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+    auto constexpr endgame_fen = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+    auto constexpr promotions_fen = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+
+    void bench_perft(benchmark::State& state, char const * fen)
+    {
+        auto board = from_fen(fen);
+        auto const depth = static_cast<int>(state.range(0));
+        auto nodes = std::uint64_t{};
+
+        for (auto _ : state)
+        {
+            nodes = chess::perft(board, depth);
+            benchmark::DoNotOptimize(nodes);
+        }
+
+        state.counters["nodes"] = static_cast<double>(nodes);
+        state.counters["nodes/s"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    void bench_perft_standard_board(benchmark::State& state)
+    {
+        bench_perft(state, chess::text::standard_fen);
+    }
+
+    void bench_perft_kiwipete(benchmark::State& state)
+    {
+        bench_perft(state, kiwipete_fen);
+    }
+
+    void bench_perft_endgame(benchmark::State& state)
+    {
+        bench_perft(state, endgame_fen);
+    }
+
+    void bench_perft_promotions(benchmark::State& state)
+    {
+        bench_perft(state, promotions_fen);
+    }
+}
+
+BENCHMARK(bench_perft_standard_board)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_perft_kiwipete)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_perft_endgame)->DenseRange(1, 5)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_perft_promotions)->DenseRange(1, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
@@ -0,0 +1,56 @@
+#include <chess/perft.h>
+#include <chess/available_moves.h>
+
+using chess::Board;
+using chess::MoveList;
+using chess::PerftDivide;
+
+std::uint64_t chess::perft(Board & board, int depth)
+{
+    if (depth == 0)
+    {
+        return 1;
+    }
+
+    auto plies = MoveList{};
+    available_plies(board, plies);
+
+    // Every legal ply is one leaf, no need to play them.
+    if (depth == 1)
+    {
+        return plies.size();
+    }
+
+    auto nodes = std::uint64_t{};
+
+    for (auto ply : plies)
+    {
+        auto undo = board.make(ply);
+        nodes += perft(board, depth - 1);
+        board.unmake(ply, undo);
+    }
+
+    return nodes;
+}
+
+std::vector<PerftDivide> chess::perft_divide(Board & board, int depth)
+{
+    auto divide = std::vector<PerftDivide>{};
+
+    if (depth == 0)
+    {
+        return divide;
+    }
+
+    auto plies = MoveList{};
+    available_plies(board, plies);
+
+    for (auto ply : plies)
+    {
+        auto undo = board.make(ply);
+        divide.push_back({ply, perft(board, depth - 1)});
+        board.unmake(ply, undo);
+    }
+
+    return divide;
+}
@@ -13,6 +13,8 @@ using chess::Square;
 using chess::SquareType;
 using chess::Colour;
 using chess::Move;
+using chess::Ply;
+using chess::PlyKind;
 using chess::pgn::SanMove;
 
 namespace
@@ -25,50 +27,34 @@ namespace
     auto constexpr black_kingside_rook_loc = Loc{"H8"};
     auto constexpr black_queenside_rook_loc = Loc{"A8"};
 
-    std::optional<Loc> find_loc_of(Board const &b, Square sq)
+    /**
+     * The type of piece that ends up on the destination square.
+     */
+    SquareType moved_type(Board const& board, Ply ply)
     {
-        for (auto const& loc : Loc::all_squares())
-        {
-            auto other = b[loc];
-            if (other == sq)
-            {
-                return loc;
-            }
-        }
-
-        return std::nullopt;
+        return ply.kind() == PlyKind::promotion ? ply.promotion() : board[ply.src()].type();
     }
 
-    bool is_en_passant(Move const& move)
+    bool is_capture(Board const& board, Ply ply)
     {
-        auto dx = std::abs(move.src.x() - move.dest.x());
-        auto dy = std::abs(move.src.y() - move.dest.y());
-        auto type = move.result[move.dest].type();
-
-        return dx == 1 && dy == 1 && type == SquareType::pawn;
-    }
-
-    bool is_capture(Board const& board, Move const& move)
-    {
-        if (is_en_passant(move))
+        if (ply.kind() == PlyKind::en_passant)
         {
             return true;
         }
-        return board[move.dest].type() != SquareType::empty
-                && board[move.dest].colour() != move.result[move.dest].colour();
+        return board[ply.dest()].type() != SquareType::empty
+                && board[ply.dest()].colour() != board[ply.src()].colour();
     }
 
-    bool caused_mate(Board board, Move const &move)
+    bool caused_mate(Board board, Ply ply)
     {
         // HACK: If opponent has no king, you can't be checkmated
-        if (!find_loc_of(board, chess::King(flip_colour(board.turn))))
+        if (!board.king(flip_colour(board.turn)))
         {
             return false;
         }
 
-        board = move.result;
-        auto next_moves = chess::available_moves(board);
-        return next_moves.empty();
+        board.make(ply);
+        return !chess::has_legal_move(board);
     }
 
     Loc get_castling_rook(Board const& board, SanMove const& san)
@@ -98,25 +84,26 @@ namespace
 
 std::optional<Move> chess::pgn::resolve_move(SanMove const& san, Board const& board)
 {
-    auto moves = available_moves(board);
+    auto moves = chess::MoveList{};
+    available_plies(board, moves);
 
     if (san.dest_x && san.dest_y)
     {
         // Remove moves for other pieces.
-        auto remove_it = std::remove_if(begin(moves), end(moves), [&san](Move m)
+        auto remove_it = std::remove_if(moves.begin(), moves.end(), [&san, &board](Ply m)
         {
-            return san.type != m.result[m.dest].type() && !(san.type == SquareType::pawn && san.promotion);
+            return san.type != moved_type(board, m) && !(san.type == SquareType::pawn && san.promotion);
         });
-        moves.erase(remove_it, end(moves));
+        moves.erase(remove_it, moves.end());
 
         auto dest = Loc{*san.dest_x, *san.dest_y};
-        remove_it = std::remove_if(begin(moves), end(moves), [&dest, &san, &board](Move m)
+        remove_it = std::remove_if(moves.begin(), moves.end(), [&dest, &san, &board](Ply m)
         {
-            bool correct_promotion_flag = san.promotion.has_value() == m.is_promotion;
-            bool correct_type_or_promoted = san.type == m.result[m.dest].type() || (san.type == SquareType::pawn && san.promotion);
-            bool same_destination = dest == m.dest;
-            bool correct_src_x_if_present = !san.src_x || san.src_x == m.src.x();
-            bool correct_src_y_if_present = !san.src_y || san.src_y == m.src.y();
+            bool correct_promotion_flag = san.promotion.has_value() == (m.kind() == PlyKind::promotion);
+            bool correct_type_or_promoted = san.type == moved_type(board, m) || (san.type == SquareType::pawn && san.promotion);
+            bool same_destination = dest == m.dest();
+            bool correct_src_x_if_present = !san.src_x || san.src_x == m.src().x();
+            bool correct_src_y_if_present = !san.src_y || san.src_y == m.src().y();
             bool correct_capture_flag = san.capture == is_capture(board, m);
 
             bool valid_move = same_destination
@@ -131,19 +118,21 @@ std::optional<Move> chess::pgn::resolve_move(SanMove const& san, Board const& bo
                 return true;
             }
 
+            // Only the few moves that match the SAN this far are worth classifying.
+            auto type = chess::classify(board, m);
             auto is_mate = caused_mate(board, m);
 
             // Complicated logic since the SAN does not say 'in check' if it's marked as checkmate.
-            bool marked_check_and_isnt = san.check && m.type != MoveType::check;
+            bool marked_check_and_isnt = san.check && type != MoveType::check;
             bool marked_checkmate_but_isnt = san.checkmate != is_mate;
-            bool not_marked_check_but_caused_check = !san.check && !is_mate && m.type == MoveType::check;
-            bool stalemate = is_mate && m.type != MoveType::check;
+            bool not_marked_check_but_caused_check = !san.check && !is_mate && type == MoveType::check;
+            bool stalemate = is_mate && type != MoveType::check;
 
             return marked_check_and_isnt
                     || not_marked_check_but_caused_check
                     || (marked_checkmate_but_isnt && !stalemate);
         });
-        moves.erase(remove_it, end(moves));
+        moves.erase(remove_it, moves.end());
     }
     else if (san.king_side_castle || san.queen_side_castle)
     {
@@ -155,26 +144,26 @@ std::optional<Move> chess::pgn::resolve_move(SanMove const& san, Board const& bo
             return std::nullopt;
         }
 
-        auto remove_it = std::remove_if(begin(moves), end(moves), [&board, &king_loc, &san](Move m)
+        auto remove_it = std::remove_if(moves.begin(), moves.end(), [&king_loc, &san](Ply m)
         {
-            return m.result[castling_king_dest(king_loc, san)] != King(board.turn);
+            return m.kind() != PlyKind::castling || m.dest() != castling_king_dest(king_loc, san);
         });
-        moves.erase(remove_it, end(moves));
+        moves.erase(remove_it, moves.end());
     }
 
     if (san.promotion)
     {
-        auto remove_it = std::remove_if(begin(moves), end(moves), [&san](Move m)
+        auto remove_it = std::remove_if(moves.begin(), moves.end(), [&san, &board](Ply m)
         {
-            return m.result[m.dest].type() != san.promotion;
+            return moved_type(board, m) != san.promotion;
         });
-        moves.erase(remove_it, end(moves));
+        moves.erase(remove_it, moves.end());
     }
 
     if (moves.size() == 1)
     {
-        return moves.front();
+        return to_move(board, moves[0]);
     }
 
     return std::nullopt;
-}
\ No newline at end of file
+}
@@ -0,0 +1,121 @@
+#include <chess/scan.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <cstdint>
+
+using chess::Bitboard;
+using chess::Square;
+using chess::scan::Squares;
+
+namespace
+{
+    static_assert(sizeof(Square) == 1 && sizeof(Squares) == chess::Loc::board_size,
+                  "Scanning relies on squares being single packed bytes");
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    char const * bytes_of(Squares const& squares)
+    {
+        return reinterpret_cast<char const *>(squares.data());
+    }
+
+    char to_char(std::byte b)
+    {
+        return static_cast<char>(std::to_integer<unsigned char>(b));
+    }
+#endif
+
+#if defined(__AVX2__)
+    // Each 32 byte lane gives 32 bits of the result, in square order.
+    constexpr int lane_size = 32;
+    using Lane = __m256i;
+
+    Lane load(char const * p) { return _mm256_loadu_si256(reinterpret_cast<Lane const *>(p)); }
+    Lane splat(std::byte b) { return _mm256_set1_epi8(to_char(b)); }
+    Lane lane_and(Lane a, Lane b) { return _mm256_and_si256(a, b); }
+    Lane lane_equal(Lane a, Lane b) { return _mm256_cmpeq_epi8(a, b); }
+    Bitboard lane_bits(Lane a) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(a)); }
+#elif defined(__SSE2__)
+    constexpr int lane_size = 16;
+    using Lane = __m128i;
+
+    Lane load(char const * p) { return _mm_loadu_si128(reinterpret_cast<Lane const *>(p)); }
+    Lane splat(std::byte b) { return _mm_set1_epi8(to_char(b)); }
+    Lane lane_and(Lane a, Lane b) { return _mm_and_si128(a, b); }
+    Lane lane_equal(Lane a, Lane b) { return _mm_cmpeq_epi8(a, b); }
+    Bitboard lane_bits(Lane a) { return static_cast<std::uint16_t>(_mm_movemask_epi8(a)); }
+#endif
+}
+
+Bitboard chess::scan::detail::matching_scalar(Squares const& squares, std::byte mask, std::byte value)
+{
+    auto result = Bitboard{};
+    for (int i = 0; i < Loc::board_size; ++i)
+    {
+        if ((squares[i].bits() & mask) == value)
+        {
+            result |= Bitboard{1} << i;
+        }
+    }
+    return result;
+}
+
+Bitboard chess::scan::detail::differing_scalar(Squares const& lhs, Squares const& rhs)
+{
+    auto result = Bitboard{};
+    for (int i = 0; i < Loc::board_size; ++i)
+    {
+        if (lhs[i].bits() != rhs[i].bits())
+        {
+            result |= Bitboard{1} << i;
+        }
+    }
+    return result;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+Bitboard chess::scan::matching(Squares const& squares, std::byte mask, std::byte value)
+{
+    auto const bytes = bytes_of(squares);
+    auto const masks = splat(mask);
+    auto const values = splat(value);
+    auto result = Bitboard{};
+
+    for (int i = 0; i < Loc::board_size; i += lane_size)
+    {
+        result |= lane_bits(lane_equal(lane_and(load(bytes + i), masks), values)) << i;
+    }
+
+    return result;
+}
+
+Bitboard chess::scan::differing(Squares const& lhs, Squares const& rhs)
+{
+    auto const lhs_bytes = bytes_of(lhs);
+    auto const rhs_bytes = bytes_of(rhs);
+    auto same = Bitboard{};
+
+    for (int i = 0; i < Loc::board_size; i += lane_size)
+    {
+        same |= lane_bits(lane_equal(load(lhs_bytes + i), load(rhs_bytes + i))) << i;
+    }
+
+    return ~same;
+}
+
+#else
+
+Bitboard chess::scan::matching(Squares const& squares, std::byte mask, std::byte value)
+{
+    return detail::matching_scalar(squares, mask, value);
+}
+
+Bitboard chess::scan::differing(Squares const& lhs, Squares const& rhs)
+{
+    return detail::differing_scalar(lhs, rhs);
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include <chess/see.h>
+#include <chess/attacks.h>
+#include <chess/Board.h>
+
+#include <algorithm>
+#include <array>
+
+using chess::Bitboard;
+using chess::Board;
+using chess::Colour;
+using chess::Loc;
+using chess::Ply;
+using chess::PlyKind;
+using chess::SquareType;
+
+namespace
+{
+    // Cheapest first, the order attackers are brought into the exchange.
+    constexpr std::array<SquareType, 6> by_value = {
+            SquareType::pawn, SquareType::knight, SquareType::bishop,
+            SquareType::rook, SquareType::queen, SquareType::king,
+    };
+
+    // Every piece on the board can capture at most once, plus the ply itself.
+    constexpr int max_exchanges = 33;
+}
+
+int chess::see(Board const& board, Ply ply)
+{
+    if (ply.kind() == PlyKind::castling)
+    {
+        return 0;
+    }
+
+    auto const src = ply.src();
+    auto const dest = ply.dest();
+    auto const mover = board[src];
+
+    auto occupied = board.occupied() & ~bit(src);
+    auto captured = board[dest].type();
+
+    if (ply.kind() == PlyKind::en_passant)
+    {
+        captured = SquareType::pawn;
+        occupied &= ~bit(Loc{dest.x(), src.y()});
+    }
+
+    auto gain = std::array<int, max_exchanges>{};
+    gain[0] = piece_value(captured);
+
+    // The piece left standing on dest, next in line to be captured.
+    auto on_dest = mover.type();
+    if (ply.kind() == PlyKind::promotion)
+    {
+        on_dest = ply.promotion();
+        gain[0] += piece_value(on_dest) - piece_value(SquareType::pawn);
+    }
+
+    auto const diagonal = board.pieces(SquareType::bishop) | board.pieces(SquareType::queen);
+    auto const straight = board.pieces(SquareType::rook) | board.pieces(SquareType::queen);
+
+    auto attackers = attackers_to(board, dest, Colour::white, occupied) | attackers_to(board, dest, Colour::black, occupied);
+    auto side = flip_colour(mover.colour());
+    auto depth = 0;
+
+    while (true)
+    {
+        attackers &= occupied;
+        auto const ours = attackers & board.pieces(side);
+        if (!ours)
+        {
+            break;
+        }
+
+        auto const type = *std::find_if(by_value.begin(), by_value.end(),
+                                        [&](SquareType t) { return (ours & board.pieces(t)) != 0; });
+
+        // A king can only take if nothing would take it back.
+        if (type == SquareType::king && (attackers & board.pieces(flip_colour(side))))
+        {
+            break;
+        }
+
+        ++depth;
+        gain[depth] = piece_value(on_dest) - gain[depth - 1];
+
+        // If the side to capture is behind whether it captures or not, the rest of the exchange cannot change the
+        // result, so the earlier captures stand as they are.
+        if (std::max(-gain[depth - 1], gain[depth]) < 0)
+        {
+            --depth;
+            break;
+        }
+
+        occupied &= ~bit(lsb(ours & board.pieces(type)));
+        attackers |= (bishop_attacks(dest, occupied) & diagonal) | (rook_attacks(dest, occupied) & straight);
+        on_dest = type;
+        side = flip_colour(side);
+    }
+
+    // Each side may stop capturing whenever carrying on would lose, so fold back from the end of the exchange.
+    while (depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        --depth;
+    }
+
+    return gain[0];
+}
@@ -0,0 +1,155 @@
+#include <chess/attacks.h>
+#include <chess/Board.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+
+namespace chess
+{
+    namespace
+    {
+        Bitboard bits(std::initializer_list<char const *> locs)
+        {
+            auto bb = Bitboard{};
+            for (auto loc : locs)
+            {
+                bb |= bit(Loc{loc});
+            }
+            return bb;
+        }
+
+        auto constexpr white = Colour::white;
+        auto constexpr black = Colour::black;
+
+        /**
+         * Slider attacks the slow way, stepping out from the origin until the edge of the board or an occupied square.
+         */
+        Bitboard walk(Loc origin, Bitboard occupied, std::initializer_list<std::pair<int, int>> directions)
+        {
+            auto attacks = Bitboard{};
+
+            for (auto [dx, dy] : directions)
+            {
+                for (auto current = Loc::add_delta(origin, dx, dy); current; current = Loc::add_delta(*current, dx, dy))
+                {
+                    attacks |= bit(*current);
+                    if (contains(occupied, *current))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            return attacks;
+        }
+    }
+
+    TEST(attacks_test, step_matches_add_delta)
+    {
+        for (auto const& origin : Loc::all_squares())
+        {
+            for (int dx = -2; dx <= 2; ++dx)
+            {
+                for (int dy = -2; dy <= 2; ++dy)
+                {
+                    EXPECT_EQ(Loc::add_delta(origin, dx, dy), detail::step(origin, dx, dy))
+                            << origin.index() << " " << dx << " " << dy;
+                }
+            }
+        }
+    }
+
+    TEST(attacks_test, leaper_tables_stay_on_the_board)
+    {
+        static_assert(popcount(knight_attacks(Loc{"D4"})) == 8, "tables are usable at compile time");
+
+        EXPECT_EQ(bits({"B3", "C2"}), knight_attacks("A1"));
+        EXPECT_EQ(bits({"A2", "B1", "B2"}), king_attacks("A1"));
+        EXPECT_EQ(bits({"B3"}), pawn_attacks(white, "A2"));
+        EXPECT_EQ(bits({"G6"}), pawn_attacks(black, "H7"));
+    }
+
+    TEST(attacks_test, sliders_stop_at_the_first_piece)
+    {
+        auto occupied = bits({"D6", "F4", "B2"});
+
+        EXPECT_EQ(bits({"D5", "D6", "D3", "D2", "D1", "E4", "F4", "C4", "B4", "A4"}), rook_attacks("D4", occupied));
+        EXPECT_EQ(bits({"E5", "F6", "G7", "H8", "C5", "B6", "A7", "E3", "F2", "G1", "C3", "B2"}),
+                  bishop_attacks("D4", occupied));
+    }
+
+    TEST(attacks_test, slider_tables_match_walking_the_rays)
+    {
+        auto rng = std::mt19937_64{20240};
+
+        for (int round = 0; round < 200; ++round)
+        {
+            // Sparse and dense boards both, by combining random words.
+            auto const occupied = round % 2 == 0 ? rng() & rng() & rng() : rng() | rng();
+
+            for (auto loc : Loc::all_squares())
+            {
+                EXPECT_EQ(walk(loc, occupied, {{1, 0}, {-1, 0}, {0, 1}, {0, -1}}), rook_attacks(loc, occupied))
+                        << "rook at " << loc.index() << " with " << occupied;
+                EXPECT_EQ(walk(loc, occupied, {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}), bishop_attacks(loc, occupied))
+                        << "bishop at " << loc.index() << " with " << occupied;
+            }
+        }
+    }
+
+    TEST(attacks_test, between_and_line_need_aligned_squares)
+    {
+        EXPECT_EQ(bits({"B1", "C1", "D1"}), between("A1", "E1"));
+        EXPECT_EQ(bits({"B2", "C3"}), between("D4", "A1"));
+        EXPECT_EQ(Bitboard{}, between("A1", "B3"));
+        EXPECT_EQ(Bitboard{}, line("A1", "B3"));
+        EXPECT_TRUE(contains(line("C3", "E5"), "A1"));
+        EXPECT_TRUE(contains(line("C3", "E5"), "H8"));
+    }
+
+    TEST(attacks_test, attackers_to_finds_every_attacker)
+    {
+        auto board = Board::with_pieces({
+                {"E4", King(white)},
+                {"D6", Knight(black)},
+                {"F5", Pawn(black)},
+                {"E8", Rook(black)},
+                {"B7", Bishop(black)},
+                {"C6", Pawn(black)},
+                {"E3", Pawn(black)},
+        });
+
+        EXPECT_EQ(bits({"D6", "F5", "E8"}), attackers_to(board, "E4", black));
+        EXPECT_EQ(bits({"E4"}), attackers_to(board, "E3", white));
+
+        // Seeing through the pawn on C6 uncovers the bishop.
+        EXPECT_EQ(bits({"D6", "F5", "E8", "B7"}), attackers_to(board, "E4", black, board.occupied() & ~bit("C6")));
+    }
+
+    TEST(attacks_test, attacked_by_covers_every_piece)
+    {
+        auto board = Board::with_pieces({
+                {"A2", Pawn(white)},
+                {"H2", Pawn(white)},
+                {"B1", Knight(white)},
+        });
+
+        EXPECT_EQ(bits({"B3", "G3", "A3", "C3", "D2"}), attacked_by(board, white));
+        EXPECT_EQ(Bitboard{}, attacked_by(board, black));
+    }
+
+    TEST(attacks_test, in_check_is_about_the_player_to_move)
+    {
+        auto board = Board::with_pieces({
+                {"E1", King(white)},
+                {"E8", Rook(black)},
+        });
+
+        EXPECT_TRUE(in_check(board));
+
+        board.turn = black;
+        EXPECT_FALSE(in_check(board));
+    }
+}
@@ -77,4 +77,88 @@ namespace chess
 
         EXPECT_EQ(MoveType::checkmate, move.type);
     }
-}
\ No newline at end of file
+
+    TEST_F(AvailableMovesFixture, lazy_moves_are_unclassified_until_asked)
+    {
+        auto board = Board::with_pieces({
+                {"C7", Rook(Colour::black)},
+                {"B8", Rook(Colour::black)},
+                {"A1", King(Colour::white)},
+        });
+        board.turn = Colour::black;
+
+        auto moves = available_moves(board, Classification::lazy);
+        auto mate = find_first("C7", "A7", moves);
+        auto check = find_first("C7", "C1", moves);
+        auto quiet = find_first("C7", "D7", moves);
+
+        EXPECT_EQ(MoveType::unclassified, mate.type);
+        EXPECT_EQ(MoveType::checkmate, classify(mate));
+        EXPECT_EQ(MoveType::check, classify(check));
+        EXPECT_EQ(MoveType::normal, classify(quiet));
+        EXPECT_EQ(MoveType::checkmate, classify(board, Ply{"C7", "A7"}));
+    }
+
+    TEST_F(AvailableMovesFixture, captures_include_en_passant_and_every_promotion)
+    {
+        auto board = Board::with_pieces({
+                {"E1", King(Colour::white)},
+                {"E5", Pawn(Colour::white)},
+                {"B7", Pawn(Colour::white)},
+                {"C8", Knight(Colour::black)},
+                {"D5", Pawn(Colour::black)},
+                {"F6", Pawn(Colour::black)},
+                {"H8", King(Colour::black)},
+        });
+        board.last_turn_pawn_double_jump_dest = Loc{"D5"};
+
+        auto captures = available_captures(board);
+
+        auto count = [&captures](Loc src, Loc dest)
+        {
+            return std::count_if(begin(captures), end(captures), [&](Ply ply)
+            {
+                return ply.src() == src && ply.dest() == dest;
+            });
+        };
+
+        EXPECT_EQ(1, count("E5", "F6"));
+        EXPECT_EQ(1, count("E5", "D6"));
+        EXPECT_EQ(4, count("B7", "B8"));
+        EXPECT_EQ(4, count("B7", "C8"));
+        EXPECT_EQ(10, captures.size());
+    }
+
+    TEST_F(AvailableMovesFixture, captures_are_still_legal_moves)
+    {
+        // The bishop is pinned to its king, so may only capture the queen pinning it.
+        auto board = Board::with_pieces({
+                {"A1", King(Colour::white)},
+                {"B2", Bishop(Colour::white)},
+                {"D4", Queen(Colour::black)},
+                {"A3", Pawn(Colour::black)},
+        });
+
+        auto captures = available_captures(board);
+
+        EXPECT_EQ(1, captures.size());
+        EXPECT_EQ(Ply("B2", "D4"), captures.front());
+    }
+
+    TEST_F(AvailableMovesFixture, has_legal_move_is_false_for_checkmate_and_stalemate)
+    {
+        auto mated = Board::with_pieces({
+                {"A7", Rook(Colour::black)},
+                {"B8", Rook(Colour::black)},
+                {"A1", King(Colour::white)},
+        });
+        auto stalemated = Board::with_pieces({
+                {"B3", Queen(Colour::black)},
+                {"A1", King(Colour::white)},
+        });
+
+        EXPECT_FALSE(has_legal_move(mated));
+        EXPECT_FALSE(has_legal_move(stalemated));
+        EXPECT_TRUE(has_legal_move(Board::standard()));
+    }
+}
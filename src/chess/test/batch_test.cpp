@@ -0,0 +1,70 @@
+#include <chess/batch.h>
+#include <chess/available_moves.h>
+#include <chess/text/fen.h>
+
+#include <gtest/gtest.h>
+
+namespace chess
+{
+    namespace
+    {
+        std::vector<Board> some_boards()
+        {
+            auto const fens = {
+                    text::standard_fen,
+                    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                    "rnbqkbnr/ppppp2p/5p2/6pQ/4P3/8/PPPP1PPP/RNB1KBNR b KQkq - 1 3",
+            };
+
+            auto boards = std::vector<Board>{};
+            for (int copy = 0; copy < 100; ++copy)
+            {
+                for (auto fen : fens)
+                {
+                    boards.push_back(text::from_fen(fen));
+                }
+            }
+            return boards;
+        }
+    }
+
+    TEST(batch_test, plies_match_one_at_a_time_generation)
+    {
+        auto const boards = some_boards();
+        auto pool = perf::ThreadPool{4};
+
+        auto const batch = available_plies(boards, pool);
+
+        ASSERT_EQ(boards.size(), batch.size());
+        for (std::size_t i = 0; i < boards.size(); ++i)
+        {
+            EXPECT_EQ(available_plies(boards[i]), batch[i]);
+        }
+    }
+
+    TEST(batch_test, counts_match_one_at_a_time_generation)
+    {
+        auto const boards = some_boards();
+        auto pool = perf::ThreadPool{4};
+
+        auto const counts = count_plies(boards, pool);
+
+        ASSERT_EQ(boards.size(), counts.size());
+        EXPECT_EQ(20, counts[0]);
+        EXPECT_EQ(48, counts[1]);
+        EXPECT_EQ(14, counts[2]);
+        EXPECT_EQ(0, counts[3]);
+        for (std::size_t i = 0; i < boards.size(); ++i)
+        {
+            EXPECT_EQ(available_plies(boards[i]).size(), counts[i]);
+        }
+    }
+
+    TEST(batch_test, no_boards_gives_no_results)
+    {
+        auto pool = perf::ThreadPool{2};
+        EXPECT_TRUE(available_plies(std::vector<Board>{}, pool).empty());
+        EXPECT_TRUE(count_plies(std::vector<Board>{}, pool).empty());
+    }
+}
@@ -0,0 +1,278 @@
+#include <chess/Board.h>
+
+#include <gtest/gtest.h>
+
+namespace chess
+{
+    namespace
+    {
+        auto constexpr white = Colour::white;
+        auto constexpr black = Colour::black;
+
+        void expect_same_board(Board const& expected, Board const& actual)
+        {
+            for (auto loc : Loc::all_squares())
+            {
+                EXPECT_EQ(expected[loc], actual[loc]) << "at index " << loc.index();
+                EXPECT_EQ(expected[loc].has_moved(), actual[loc].has_moved()) << "at index " << loc.index();
+            }
+
+            EXPECT_EQ(expected.turn, actual.turn);
+            EXPECT_EQ(expected.last_turn_pawn_double_jump_dest, actual.last_turn_pawn_double_jump_dest);
+            EXPECT_EQ(expected.occupied(), actual.occupied());
+            EXPECT_EQ(expected.pieces(white), actual.pieces(white));
+            EXPECT_EQ(expected.pieces(SquareType::pawn), actual.pieces(SquareType::pawn));
+        }
+
+        /**
+         * Every square's bit is set in exactly the bitboards for its type and colour, and in none if it is empty.
+         */
+        void expect_bitboards_match_squares(Board const& board)
+        {
+            auto const types = {SquareType::pawn, SquareType::rook, SquareType::knight, SquareType::bishop,
+                                SquareType::queen, SquareType::king};
+
+            for (auto loc : Loc::all_squares())
+            {
+                auto const sq = board[loc];
+                auto const occupied = sq.type() != SquareType::empty;
+
+                EXPECT_EQ(occupied, contains(board.occupied(), loc)) << "at index " << loc.index();
+                for (auto colour : {white, black})
+                {
+                    EXPECT_EQ(occupied && sq.colour() == colour, contains(board.pieces(colour), loc))
+                            << "at index " << loc.index();
+                }
+                for (auto type : types)
+                {
+                    EXPECT_EQ(sq.type() == type, contains(board.pieces(type), loc)) << "at index " << loc.index();
+                }
+            }
+        }
+    }
+
+    TEST(board_test, bitboards_follow_every_kind_of_write)
+    {
+        auto board = Board::standard();
+        expect_bitboards_match_squares(board);
+
+        // Replacing a piece with one of another type and colour, directly and through the proxy.
+        board.set("D2", Queen(black));
+        board["E7"] = Knight(white);
+        expect_bitboards_match_squares(board);
+
+        // Clearing squares, and copying one square over another.
+        board["A1"] = Empty();
+        board.set("H8", Empty());
+        board["C3"] = board["G8"];
+        expect_bitboards_match_squares(board);
+
+        // Changing only the type, as promotion does, and marking a piece moved.
+        board["B2"].set_type(SquareType::queen);
+        board["B1"].set_moved();
+        expect_bitboards_match_squares(board);
+    }
+
+    TEST(board_test, assigning_squares_updates_bitboards)
+    {
+        auto board = Board::blank();
+        board["C3"] = Knight(white);
+        board["D4"] = Pawn(black);
+
+        EXPECT_EQ(bit("C3") | bit("D4"), board.occupied());
+        EXPECT_EQ(bit("C3"), board.pieces(white, SquareType::knight));
+        EXPECT_EQ(bit("D4"), board.pieces(black));
+
+        board["C3"] = board["D4"];
+        EXPECT_EQ(bit("C3") | bit("D4"), board.pieces(SquareType::pawn));
+        EXPECT_EQ(0u, board.pieces(white));
+    }
+
+    TEST(board_test, make_moves_piece_and_flips_turn)
+    {
+        auto board = Board::standard();
+        board.make({"G1", "F3"});
+
+        EXPECT_EQ(Knight(white), board["F3"]);
+        EXPECT_TRUE(board["F3"].has_moved());
+        EXPECT_EQ(Empty(), board["G1"]);
+        EXPECT_EQ(black, board.turn);
+    }
+
+    TEST(board_test, make_then_unmake_capture_restores_board)
+    {
+        auto board = Board::with_pieces({
+                {"C3", Knight(white)},
+                {"D5", Pawn(black)},
+        });
+        auto const before = board;
+
+        auto undo = board.make({"C3", "D5"});
+        EXPECT_EQ(Knight(white), board["D5"]);
+
+        board.unmake({"C3", "D5"}, undo);
+        expect_same_board(before, board);
+    }
+
+    TEST(board_test, make_then_unmake_castling_restores_board)
+    {
+        auto board = Board::with_pieces({
+                {"E1", King(white)},
+                {"A1", Rook(white)},
+        });
+        auto const before = board;
+        auto const ply = Ply{"E1", "C1", PlyKind::castling};
+
+        auto undo = board.make(ply);
+        EXPECT_EQ(King(white), board["C1"]);
+        EXPECT_EQ(Rook(white), board["D1"]);
+        EXPECT_EQ(Empty(), board["A1"]);
+
+        board.unmake(ply, undo);
+        expect_same_board(before, board);
+    }
+
+    TEST(board_test, make_then_unmake_en_passant_restores_board)
+    {
+        auto board = Board::with_pieces({
+                {"E5", Pawn(white)},
+                {"D5", Pawn(black)},
+        });
+        board.last_turn_pawn_double_jump_dest = Loc{"D5"};
+        auto const before = board;
+        auto const ply = Ply{"E5", "D6", PlyKind::en_passant};
+
+        auto undo = board.make(ply);
+        EXPECT_EQ(Pawn(white), board["D6"]);
+        EXPECT_EQ(Empty(), board["D5"]);
+        EXPECT_FALSE(board.last_turn_pawn_double_jump_dest);
+
+        board.unmake(ply, undo);
+        expect_same_board(before, board);
+    }
+
+    TEST(board_test, make_then_unmake_promotion_restores_board)
+    {
+        auto board = Board::with_pieces({
+                {"B7", Pawn(white)},
+                {"A8", Rook(black)},
+        });
+        auto const before = board;
+        auto const ply = Ply{"B7", "A8", PlyKind::promotion, SquareType::knight};
+
+        auto undo = board.make(ply);
+        EXPECT_EQ(Knight(white), board["A8"]);
+
+        board.unmake(ply, undo);
+        expect_same_board(before, board);
+    }
+
+    TEST(board_test, king_follows_the_king_as_it_moves)
+    {
+        auto board = Board::with_pieces({
+                {"E1", King(white)},
+                {"A8", Rook(black)},
+        });
+
+        EXPECT_EQ(Loc{"E1"}, board.king(white));
+        EXPECT_FALSE(board.king(black));
+
+        auto const ply = Ply{"E1", "E2"};
+        auto undo = board.make(ply);
+        EXPECT_EQ(Loc{"E2"}, board.king(white));
+
+        board.unmake(ply, undo);
+        EXPECT_EQ(Loc{"E1"}, board.king(white));
+    }
+
+    TEST(board_test, hash_is_restored_by_unmake)
+    {
+        auto board = Board::standard();
+        auto const before = board.hash();
+        auto const ply = Ply{"E2", "E4", PlyKind::pawn_double_jump};
+
+        auto undo = board.make(ply);
+        EXPECT_NE(before, board.hash());
+
+        board.unmake(ply, undo);
+        EXPECT_EQ(before, board.hash());
+    }
+
+    TEST(board_test, hash_matches_for_transposed_positions)
+    {
+        auto knights_first = Board::standard();
+        knights_first.make({"G1", "F3"});
+        knights_first.make({"G8", "F6"});
+        knights_first.make({"B1", "C3"});
+
+        auto other_knight_first = Board::standard();
+        other_knight_first.make({"B1", "C3"});
+        other_knight_first.make({"G8", "F6"});
+        other_knight_first.make({"G1", "F3"});
+
+        EXPECT_EQ(knights_first.hash(), other_knight_first.hash());
+    }
+
+    TEST(board_test, hash_depends_on_turn_and_castling_rights)
+    {
+        auto board = Board::with_pieces({
+                {"E1", King(white)},
+                {"H1", Rook(white)},
+                {"E8", King(black)},
+        });
+        auto const start = board.hash();
+
+        board.turn = black;
+        EXPECT_NE(start, board.hash());
+        board.turn = white;
+
+        // Moving the rook out and back loses the right to castle that way.
+        board.make({"H1", "H2"});
+        board.make({"E8", "E7"});
+        board.make({"H2", "H1"});
+        board.make({"E7", "E8"});
+        EXPECT_NE(start, board.hash());
+    }
+
+    TEST(board_test, with_pieces_matches_placing_one_at_a_time)
+    {
+        auto const placed = Board::with_pieces({
+                {"E1", King(white)},
+                {"H1", Rook(white)},
+                {"D7", Square{SquareType::pawn, black, true}},
+                {"E8", King(black)},
+        });
+
+        auto set_one_by_one = Board::blank();
+        set_one_by_one["E1"] = King(white);
+        set_one_by_one["H1"] = Rook(white);
+        set_one_by_one["D7"] = Square{SquareType::pawn, black, true};
+        set_one_by_one["E8"] = King(black);
+
+        expect_same_board(set_one_by_one, placed);
+        EXPECT_EQ(set_one_by_one.pieces(black, SquareType::king), placed.pieces(black, SquareType::king));
+        EXPECT_EQ(set_one_by_one.hash(), placed.hash());
+    }
+
+    TEST(board_test, boards_compare_squares_turn_and_double_jump)
+    {
+        auto const start = Board::standard();
+        auto board = Board::standard();
+        EXPECT_EQ(start, board);
+
+        auto const ply = Ply{"E2", "E4", PlyKind::pawn_double_jump};
+        auto undo = board.make(ply);
+        EXPECT_NE(start, board);
+
+        board.unmake(ply, undo);
+        EXPECT_EQ(start, board);
+
+        board.turn = black;
+        EXPECT_NE(start, board);
+        board.turn = white;
+
+        // A king that moved away and back has lost its castling rights, so is a different position.
+        board["E1"].set_moved();
+        EXPECT_NE(start, board);
+    }
+}
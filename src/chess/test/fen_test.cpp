@@ -0,0 +1,49 @@
+#include <chess/text/fen.h>
+
+#include <gtest/gtest.h>
+
+namespace chess
+{
+    TEST(fen_test, standard_fen_matches_standard_board)
+    {
+        auto board = text::from_fen(text::standard_fen);
+        auto standard = Board::standard();
+
+        for (auto loc : Loc::all_squares())
+        {
+            EXPECT_EQ(standard[loc], board[loc]);
+        }
+        EXPECT_EQ(Colour::white, board.turn);
+        EXPECT_EQ(standard.hash(), board.hash());
+    }
+
+    TEST(fen_test, moved_flags_follow_castling_rights_and_pawn_ranks)
+    {
+        auto board = text::from_fen("r3k2r/8/8/8/8/P7/1P6/R3K2R b Kq - 0 1");
+
+        EXPECT_EQ(Colour::black, board.turn);
+        EXPECT_FALSE(board["E1"].has_moved());
+        EXPECT_FALSE(board["H1"].has_moved());
+        EXPECT_TRUE(board["A1"].has_moved());
+        EXPECT_FALSE(board["E8"].has_moved());
+        EXPECT_FALSE(board["A8"].has_moved());
+        EXPECT_TRUE(board["H8"].has_moved());
+        EXPECT_TRUE(board["A3"].has_moved());
+        EXPECT_FALSE(board["B2"].has_moved());
+    }
+
+    TEST(fen_test, en_passant_target_marks_the_jumped_pawn)
+    {
+        auto board = text::from_fen("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2");
+        EXPECT_EQ(Loc{"D5"}, board.last_turn_pawn_double_jump_dest);
+    }
+
+    TEST(fen_test, bad_fen_throws)
+    {
+        EXPECT_THROW(text::from_fen(""), text::FenError);
+        EXPECT_THROW(text::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"), text::FenError);
+        EXPECT_THROW(text::from_fen("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"), text::FenError);
+        EXPECT_THROW(text::from_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1"), text::FenError);
+        EXPECT_THROW(text::from_fen("4k3/8/8/8/8/8/8/4K3 w K - 0 1"), text::FenError);
+    }
+}
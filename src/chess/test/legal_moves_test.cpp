@@ -0,0 +1,98 @@
+#include <chess/available_moves.h>
+#include <chess/Board.h>
+#include <chess/text/fen.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace chess
+{
+    namespace
+    {
+        std::vector<Ply> plies_from(Board const& board, Loc src)
+        {
+            auto plies = available_plies(board);
+            plies.erase(std::remove_if(plies.begin(), plies.end(), [src](Ply ply) { return ply.src() != src; }),
+                        plies.end());
+            return plies;
+        }
+
+        std::vector<int> dests_of(std::vector<Ply> const& plies)
+        {
+            auto dests = std::vector<int>{};
+            for (auto ply : plies)
+            {
+                dests.push_back(ply.dest().index());
+            }
+            std::sort(dests.begin(), dests.end());
+            return dests;
+        }
+
+        std::vector<int> indices(std::initializer_list<char const *> locs)
+        {
+            auto result = std::vector<int>{};
+            for (auto loc : locs)
+            {
+                result.push_back(Loc{loc}.index());
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        bool has_kind(std::vector<Ply> const& plies, PlyKind kind, Loc dest)
+        {
+            return std::any_of(plies.begin(), plies.end(), [&](Ply ply) { return ply.kind() == kind && ply.dest() == dest; });
+        }
+    }
+
+    TEST(legal_moves_test, pinned_piece_only_moves_along_the_pin)
+    {
+        auto const board = text::from_fen("4r1k1/8/8/8/4R3/8/8/4K3 w - - 0 1");
+        EXPECT_EQ(indices({"E2", "E3", "E5", "E6", "E7", "E8"}), dests_of(plies_from(board, "E4")));
+
+        // A bishop pinned along a file has nowhere to go.
+        auto const bishop = text::from_fen("4r1k1/8/8/8/4B3/8/8/4K3 w - - 0 1");
+        EXPECT_TRUE(plies_from(bishop, "E4").empty());
+    }
+
+    TEST(legal_moves_test, double_check_only_allows_king_moves)
+    {
+        // The rook and the knight both give check. The queen could take the knight, but that leaves the rook.
+        auto const board = text::from_fen("4r1k1/8/8/8/8/3n4/8/3QK3 w - - 0 1");
+        auto const plies = available_plies(board);
+
+        ASSERT_FALSE(plies.empty());
+        for (auto ply : plies)
+        {
+            EXPECT_EQ(Loc{"E1"}, ply.src()) << "ply to " << ply.dest().index();
+        }
+    }
+
+    TEST(legal_moves_test, en_passant_that_uncovers_a_rank_check_is_illegal)
+    {
+        // Taking en passant clears both pawns off the rank between the king and the rook.
+        auto const pinned = text::from_fen("8/8/8/KPp4r/8/8/8/4k3 w - c6 0 1");
+        EXPECT_FALSE(has_kind(plies_from(pinned, "B5"), PlyKind::en_passant, "C6"));
+
+        auto const unpinned = text::from_fen("8/8/8/KPp5/8/8/8/4k3 w - c6 0 1");
+        EXPECT_TRUE(has_kind(plies_from(unpinned, "B5"), PlyKind::en_passant, "C6"));
+    }
+
+    TEST(legal_moves_test, castling_never_crosses_an_attacked_square)
+    {
+        // The rook on f8 covers f1 so the king cannot pass it. The rook on b8 covers b1, which only the rook crosses.
+        auto const board = text::from_fen("1r3rk1/8/8/8/8/8/8/R3K2R w KQ - 0 1");
+        auto const plies = plies_from(board, "E1");
+
+        EXPECT_FALSE(has_kind(plies, PlyKind::castling, "G1"));
+        EXPECT_TRUE(has_kind(plies, PlyKind::castling, "C1"));
+
+        // Nor out of check.
+        auto const in_check = text::from_fen("4r1k1/8/8/8/8/8/8/R3K2R w KQ - 0 1");
+        auto const escapes = plies_from(in_check, "E1");
+        EXPECT_FALSE(has_kind(escapes, PlyKind::castling, "G1"));
+        EXPECT_FALSE(has_kind(escapes, PlyKind::castling, "C1"));
+    }
+}
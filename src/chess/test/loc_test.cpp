@@ -0,0 +1,46 @@
+#include <chess/Loc.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace chess
+{
+    namespace
+    {
+        std::vector<int> indices(perf::StackVector<Loc, Loc::side_size> const& locs)
+        {
+            auto result = std::vector<int>{};
+            for (auto loc : locs)
+            {
+                result.push_back(loc.index());
+            }
+            return result;
+        }
+    }
+
+    TEST(loc_test, direction_runs_to_the_edge_of_the_board)
+    {
+        EXPECT_EQ((std::vector<int>{Loc{"B2"}.index(), Loc{"C3"}.index(), Loc{"D4"}.index(), Loc{"E5"}.index(),
+                                    Loc{"F6"}.index(), Loc{"G7"}.index(), Loc{"H8"}.index()}),
+                  indices(Loc::direction("A1", Sign::positive, Sign::positive)));
+        EXPECT_EQ((std::vector<int>{Loc{"D3"}.index(), Loc{"D2"}.index(), Loc{"D1"}.index()}),
+                  indices(Loc::direction("D4", Sign::none, Sign::negative)));
+        EXPECT_TRUE(Loc::direction("H4", Sign::positive, Sign::none).empty());
+    }
+
+    TEST(loc_test, add_delta_stops_at_every_edge)
+    {
+        static_assert(Loc::add_delta("A1", 7, 7)->index() == Loc{"H8"}.index());
+
+        EXPECT_EQ(Loc{"A1"}, Loc::add_delta("H8", -7, -7));
+        EXPECT_EQ(Loc{"C2"}, Loc::add_delta("A1", 2, 1));
+        EXPECT_FALSE(Loc::add_delta("H1", 1, 0));
+        EXPECT_FALSE(Loc::add_delta("H4", 3, 0));
+        EXPECT_FALSE(Loc::add_delta("A4", -1, 0));
+        EXPECT_FALSE(Loc::add_delta("A8", 0, 1));
+        EXPECT_FALSE(Loc::add_delta("E1", 0, -1));
+        EXPECT_FALSE(Loc::add_delta("B2", -2, -7));
+        EXPECT_FALSE(Loc::add_delta("A1", 16, 0));
+    }
+}
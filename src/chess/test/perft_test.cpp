@@ -0,0 +1,95 @@
+#include <chess/perft.h>
+#include <chess/text/fen.h>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace chess
+{
+    namespace
+    {
+        std::uint64_t perft_of(char const * fen, int depth)
+        {
+            auto board = text::from_fen(fen);
+            return perft(board, depth);
+        }
+    }
+
+    // Expected node counts are the well known results from the Chess Programming Wiki's perft page. Depths are kept
+    // low enough for the test suite to stay quick.
+
+    TEST(perft_test, standard_board)
+    {
+        EXPECT_EQ(20, perft_of(text::standard_fen, 1));
+        EXPECT_EQ(400, perft_of(text::standard_fen, 2));
+        EXPECT_EQ(8902, perft_of(text::standard_fen, 3));
+        EXPECT_EQ(197281, perft_of(text::standard_fen, 4));
+    }
+
+    TEST(perft_test, kiwipete)
+    {
+        auto fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+        EXPECT_EQ(48, perft_of(fen, 1));
+        EXPECT_EQ(2039, perft_of(fen, 2));
+        EXPECT_EQ(97862, perft_of(fen, 3));
+    }
+
+    TEST(perft_test, rook_and_pawn_endgame)
+    {
+        auto fen = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+        EXPECT_EQ(14, perft_of(fen, 1));
+        EXPECT_EQ(191, perft_of(fen, 2));
+        EXPECT_EQ(2812, perft_of(fen, 3));
+        EXPECT_EQ(43238, perft_of(fen, 4));
+    }
+
+    TEST(perft_test, promotions_and_checks)
+    {
+        auto fen = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+        EXPECT_EQ(6, perft_of(fen, 1));
+        EXPECT_EQ(264, perft_of(fen, 2));
+        EXPECT_EQ(9467, perft_of(fen, 3));
+    }
+
+    TEST(perft_test, discovered_checks)
+    {
+        auto fen = "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8";
+        EXPECT_EQ(44, perft_of(fen, 1));
+        EXPECT_EQ(1486, perft_of(fen, 2));
+        EXPECT_EQ(62379, perft_of(fen, 3));
+    }
+
+    TEST(perft_test, middlegame)
+    {
+        auto fen = "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10";
+        EXPECT_EQ(46, perft_of(fen, 1));
+        EXPECT_EQ(2079, perft_of(fen, 2));
+        EXPECT_EQ(89890, perft_of(fen, 3));
+    }
+
+    TEST(perft_test, divide_sums_to_perft)
+    {
+        auto board = text::from_fen(text::standard_fen);
+        auto divide = perft_divide(board, 3);
+
+        EXPECT_EQ(20, divide.size());
+        auto total = std::accumulate(begin(divide), end(divide), std::uint64_t{}, [](auto sum, auto const& entry)
+        {
+            return sum + entry.nodes;
+        });
+        EXPECT_EQ(8902, total);
+    }
+
+    TEST(perft_test, queenside_castling_needs_b_file_empty)
+    {
+        auto board = text::from_fen("4k3/8/8/8/8/8/8/RN2K3 w Q - 0 1");
+        auto divide = perft_divide(board, 1);
+
+        auto castles = std::count_if(begin(divide), end(divide), [](auto const& entry)
+        {
+            return entry.ply.kind() == PlyKind::castling;
+        });
+        EXPECT_EQ(0, castles);
+    }
+}
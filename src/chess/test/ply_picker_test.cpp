@@ -0,0 +1,127 @@
+#include <chess/PlyPicker.h>
+#include <chess/see.h>
+#include <chess/text/fen.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace chess
+{
+    namespace
+    {
+        auto constexpr kiwipete_fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+        std::vector<Ply> pick_all(PlyPicker picker)
+        {
+            auto plies = std::vector<Ply>{};
+            while (auto ply = picker.next())
+            {
+                plies.push_back(*ply);
+            }
+            return plies;
+        }
+
+        std::vector<std::uint16_t> sorted_raw(std::vector<Ply> const& plies)
+        {
+            auto raw = std::vector<std::uint16_t>{};
+            std::transform(begin(plies), end(plies), back_inserter(raw), [](Ply ply) { return ply.raw(); });
+            std::sort(begin(raw), end(raw));
+            return raw;
+        }
+    }
+
+    TEST(ply_picker_test, gives_every_legal_ply_once)
+    {
+        for (auto fen : {text::standard_fen, kiwipete_fen, "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"})
+        {
+            auto board = text::from_fen(fen);
+            EXPECT_EQ(sorted_raw(available_plies(board)), sorted_raw(pick_all(PlyPicker{board})));
+        }
+    }
+
+    TEST(ply_picker_test, winning_captures_then_quiet_plies_then_losing_captures)
+    {
+        auto board = text::from_fen(kiwipete_fen);
+        auto plies = pick_all(PlyPicker{board});
+
+        // 0 for captures that do not lose material, 1 for quiet plies, 2 for captures that do.
+        auto order = std::vector<int>{};
+        for (auto ply : plies)
+        {
+            order.push_back(is_quiet(board, ply) ? 1 : see(board, ply) >= 0 ? 0 : 2);
+        }
+
+        EXPECT_TRUE(std::is_sorted(begin(order), end(order)));
+        EXPECT_EQ(0, order.front());
+        EXPECT_EQ(2, order.back());
+    }
+
+    TEST(ply_picker_test, captures_are_most_valuable_victim_first)
+    {
+        // The pawn can take the queen or the rook, the knight can take the queen.
+        auto board = text::from_fen("4k3/8/8/2r1q3/3P4/5N2/4P3/4K3 w - - 0 1");
+        auto picker = PlyPicker{board};
+
+        EXPECT_EQ(Ply("D4", "E5"), picker.next());
+        EXPECT_EQ(Ply("F3", "E5"), picker.next());
+        EXPECT_EQ(Ply("D4", "C5"), picker.next());
+    }
+
+    TEST(ply_picker_test, hash_ply_then_killers_are_tried_early)
+    {
+        auto board = text::from_fen(kiwipete_fen);
+        auto const hash_ply = Ply{"E2", "A6"};
+        auto const killer = Ply{"A2", "A3"};
+
+        auto plies = pick_all(PlyPicker{board, hash_ply, {killer, std::nullopt}});
+
+        EXPECT_EQ(hash_ply, plies.front());
+        EXPECT_EQ(1, std::count(begin(plies), end(plies), hash_ply));
+        EXPECT_EQ(1, std::count(begin(plies), end(plies), killer));
+
+        // The killer follows the captures that do not lose material, the hash ply among them.
+        auto const winning = std::count_if(begin(plies), end(plies), [&](Ply ply)
+        {
+            return !is_quiet(board, ply) && see(board, ply) >= 0;
+        });
+        EXPECT_EQ(killer, plies[winning]);
+        EXPECT_EQ(48, plies.size());
+    }
+
+    TEST(ply_picker_test, quiet_plies_follow_their_history)
+    {
+        auto board = text::from_fen(text::standard_fen);
+        auto history = History{};
+        history.reward(Colour::white, Ply{"G1", "F3"}, 2);
+        history.reward(Colour::white, Ply{"B1", "C3"}, 3);
+        history.reward(Colour::black, Ply{"A2", "A3"}, 10);
+
+        auto plies = pick_all(PlyPicker{board, std::nullopt, {}, &history});
+
+        EXPECT_EQ(Ply("B1", "C3"), plies[0]);
+        EXPECT_EQ(Ply("G1", "F3"), plies[1]);
+        EXPECT_EQ(20, plies.size());
+    }
+
+    TEST(ply_picker_test, illegal_hash_ply_and_killers_are_ignored)
+    {
+        auto board = text::from_fen(kiwipete_fen);
+
+        auto plies = pick_all(PlyPicker{board, Ply{"E1", "E2"}, {Ply{"A7", "A6"}, Ply{"H1", "H8"}}});
+
+        EXPECT_EQ(sorted_raw(available_plies(board)), sorted_raw(plies));
+    }
+
+    TEST(ply_picker_test, is_legal_checks_against_the_board)
+    {
+        auto board = text::from_fen(kiwipete_fen);
+
+        EXPECT_TRUE(is_legal(board, Ply{"E1", "G1", PlyKind::castling}));
+        EXPECT_TRUE(is_legal(board, Ply{"A2", "A4", PlyKind::pawn_double_jump}));
+        EXPECT_FALSE(is_legal(board, Ply{"A2", "A4"}));
+        EXPECT_FALSE(is_legal(board, Ply{"A7", "A6"}));
+        EXPECT_FALSE(is_legal(board, Ply{"E1", "E2"}));
+    }
+}
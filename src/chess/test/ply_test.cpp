@@ -0,0 +1,49 @@
+#include <chess/Ply.h>
+
+#include <gtest/gtest.h>
+
+namespace chess
+{
+    TEST(ply_test, should_be_two_bytes)
+    {
+        static_assert(sizeof(Ply) == 2);
+    }
+
+    TEST(ply_test, normal_ply_keeps_locations)
+    {
+        auto ply = Ply{"B1", "C3"};
+        EXPECT_EQ(Loc{"B1"}, ply.src());
+        EXPECT_EQ(Loc{"C3"}, ply.dest());
+        EXPECT_EQ(PlyKind::normal, ply.kind());
+        EXPECT_EQ(SquareType::empty, ply.promotion());
+    }
+
+    TEST(ply_test, special_kinds_round_trip)
+    {
+        for (auto kind : {PlyKind::pawn_double_jump, PlyKind::en_passant, PlyKind::castling})
+        {
+            auto ply = Ply{"H8", "A1", kind};
+            EXPECT_EQ(kind, ply.kind());
+            EXPECT_EQ(SquareType::empty, ply.promotion());
+            EXPECT_EQ(Loc{"H8"}, ply.src());
+            EXPECT_EQ(Loc{"A1"}, ply.dest());
+        }
+    }
+
+    TEST(ply_test, every_promotion_round_trips)
+    {
+        for (auto type : {SquareType::rook, SquareType::knight, SquareType::bishop, SquareType::queen})
+        {
+            auto ply = Ply{"G7", "H8", PlyKind::promotion, type};
+            EXPECT_EQ(PlyKind::promotion, ply.kind());
+            EXPECT_EQ(type, ply.promotion());
+        }
+    }
+
+    TEST(ply_test, raw_round_trips)
+    {
+        auto ply = Ply{"G7", "F8", PlyKind::promotion, SquareType::knight};
+        EXPECT_EQ(ply, Ply::from_raw(ply.raw()));
+        EXPECT_NE(ply, Ply::from_raw(Ply{"G7", "F8", PlyKind::promotion, SquareType::queen}.raw()));
+    }
+}
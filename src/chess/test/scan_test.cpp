@@ -0,0 +1,77 @@
+#include <chess/scan.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace chess
+{
+    namespace
+    {
+        scan::Squares random_squares(std::mt19937 & rng)
+        {
+            auto type = std::uniform_int_distribution<int>{0, static_cast<int>(SquareType::king)};
+            auto flag = std::bernoulli_distribution{};
+
+            auto squares = scan::Squares{};
+            for (auto & sq : squares)
+            {
+                auto const t = static_cast<SquareType>(type(rng));
+                sq = t == SquareType::empty ? Empty() : Square{t, flag(rng) ? Colour::white : Colour::black, flag(rng)};
+            }
+            return squares;
+        }
+    }
+
+    TEST(scan_test, type_and_colour_of_standard_rows)
+    {
+        auto squares = scan::Squares{};
+        for (auto loc : Loc::row(1))
+        {
+            squares[loc.index()] = Pawn(Colour::white);
+        }
+        squares[Loc{"E8"}.index()] = King(Colour::black);
+
+        EXPECT_EQ(0xff00ull, scan::of_type(squares, SquareType::pawn));
+        EXPECT_EQ(bit("E8"), scan::of_type(squares, SquareType::king));
+        EXPECT_EQ(0xff00ull, scan::of_colour(squares, Colour::white));
+        EXPECT_EQ(bit("E8"), scan::of_colour(squares, Colour::black));
+        EXPECT_EQ(~(0xff00ull | bit("E8")), scan::of_type(squares, SquareType::empty));
+    }
+
+    TEST(scan_test, differing_sees_moved_flags)
+    {
+        auto lhs = scan::Squares{};
+        auto rhs = scan::Squares{};
+        EXPECT_EQ(0u, scan::differing(lhs, rhs));
+
+        lhs[Loc{"A1"}.index()] = Rook(Colour::white);
+        rhs[Loc{"A1"}.index()] = Square{SquareType::rook, Colour::white, true};
+        rhs[Loc{"H8"}.index()] = Rook(Colour::black);
+
+        EXPECT_EQ(bit("A1") | bit("H8"), scan::differing(lhs, rhs));
+    }
+
+    TEST(scan_test, vector_and_scalar_scans_agree)
+    {
+        auto rng = std::mt19937{2024};
+
+        for (int round = 0; round < 200; ++round)
+        {
+            auto const lhs = random_squares(rng);
+            auto const rhs = random_squares(rng);
+
+            for (int type = 0; type <= static_cast<int>(SquareType::king); ++type)
+            {
+                auto const value = static_cast<std::byte>(type);
+                EXPECT_EQ(scan::detail::matching_scalar(lhs, Square::type_mask, value),
+                          scan::matching(lhs, Square::type_mask, value));
+            }
+
+            EXPECT_EQ(scan::detail::matching_scalar(lhs, Square::colour_mask, Square::colour_mask),
+                      scan::matching(lhs, Square::colour_mask, Square::colour_mask));
+            EXPECT_EQ(scan::detail::differing_scalar(lhs, rhs), scan::differing(lhs, rhs));
+            EXPECT_EQ(0u, scan::differing(lhs, lhs));
+        }
+    }
+}
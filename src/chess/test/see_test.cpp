@@ -0,0 +1,77 @@
+#include <chess/see.h>
+#include <chess/Board.h>
+#include <chess/text/fen.h>
+
+#include <gtest/gtest.h>
+
+namespace chess
+{
+    namespace
+    {
+        int see_of(char const * fen, Ply ply)
+        {
+            return see(text::from_fen(fen), ply);
+        }
+
+        constexpr int pawn = piece_value(SquareType::pawn);
+        constexpr int knight = piece_value(SquareType::knight);
+        constexpr int rook = piece_value(SquareType::rook);
+        constexpr int queen = piece_value(SquareType::queen);
+    }
+
+    TEST(see_test, undefended_capture_wins_the_piece)
+    {
+        EXPECT_EQ(knight, see_of("4k3/8/8/3n4/8/8/8/3RK3 w - - 0 1", {"D1", "D5"}));
+    }
+
+    TEST(see_test, defended_pawn_taken_by_queen_loses)
+    {
+        EXPECT_EQ(pawn - queen, see_of("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1", {"D1", "D5"}));
+    }
+
+    TEST(see_test, defended_pawn_taken_by_pawn_is_even)
+    {
+        EXPECT_EQ(0, see_of("4k3/8/2p5/3p4/4P3/8/8/4K3 w - - 0 1", {"E4", "D5"}));
+    }
+
+    TEST(see_test, side_with_more_attackers_wins_the_exchange)
+    {
+        // RxR RxR RxR leaves white a rook up.
+        EXPECT_EQ(rook, see_of("3rk3/8/8/3r4/8/8/3R4/3RK3 w - - 0 1", {"D2", "D5"}));
+    }
+
+    TEST(see_test, x_ray_attackers_join_in)
+    {
+        // The rook behind the queen backs it up once the queen has captured.
+        EXPECT_EQ(rook, see_of("4k3/8/8/3r4/8/8/3Q4/3RK3 w - - 0 1", {"D2", "D5"}));
+        EXPECT_EQ(rook - queen, see_of("3rk3/8/8/3r4/8/8/3Q4/4K3 w - - 0 1", {"D2", "D5"}));
+    }
+
+    TEST(see_test, bad_classic_exchange)
+    {
+        // The Chess Programming Wiki example: knight takes a pawn defended by a knight and a bishop behind it.
+        auto const fen = "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1";
+        EXPECT_EQ(pawn - knight, see_of(fen, {"D3", "E5"}));
+    }
+
+    TEST(see_test, quiet_move_onto_attacked_square_loses_the_piece)
+    {
+        EXPECT_EQ(-knight, see_of("4k3/8/8/8/1p6/8/8/3NK3 w - - 0 1", {"D1", "C3"}));
+        EXPECT_EQ(0, see_of("4k3/8/8/8/1p6/8/8/3NK3 w - - 0 1", {"D1", "E3"}));
+    }
+
+    TEST(see_test, en_passant_and_promotion)
+    {
+        EXPECT_EQ(pawn, see_of("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", {"E5", "D6", PlyKind::en_passant}));
+        EXPECT_EQ(queen - pawn, see_of("4k3/1P6/8/8/8/8/8/4K3 w - - 0 1",
+                                       {"B7", "B8", PlyKind::promotion, SquareType::queen}));
+        EXPECT_EQ(-pawn, see_of("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1",
+                                {"A7", "A8", PlyKind::promotion, SquareType::queen}));
+    }
+
+    TEST(see_test, king_only_recaptures_undefended_pieces)
+    {
+        EXPECT_EQ(pawn - queen, see_of("8/8/4k3/3p4/8/8/8/3QK3 w - - 0 1", {"D1", "D5"}));
+        EXPECT_EQ(pawn, see_of("8/8/4k3/3p4/8/8/3Q4/3RK3 w - - 0 1", {"D2", "D5"}));
+    }
+}
@@ -1,10 +1,70 @@
 #include <chess/Suggester.h>
 #include <chess/Board.h>
+#include <chess/available_moves.h>
+#include <chess/text/fen.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace chess
 {
+    namespace
+    {
+        /**
+         * Plain minimax over every line, the behaviour alpha-beta has to reproduce. Scores are from white's point of
+         * view.
+         */
+        Score minimax(Board & board, Ply ply, int depth)
+        {
+            if (depth == 1)
+            {
+                return evaluate_with_summation(to_move(board, ply));
+            }
+
+            auto undo = board.make(ply);
+            auto const replies = available_plies(board);
+
+            if (replies.empty())
+            {
+                board.unmake(ply, undo);
+                return evaluate_with_summation(to_move(board, ply));
+            }
+
+            auto const maximise = board.turn == Colour::white;
+            auto score = Score{};
+            for (std::size_t i = 0; i < replies.size(); ++i)
+            {
+                auto const child = minimax(board, replies[i], depth - 1);
+                score = i == 0 ? child : maximise ? std::max(score, child) : std::min(score, child);
+            }
+
+            board.unmake(ply, undo);
+            return score;
+        }
+
+        Ply minimax_best(Board board, int depth)
+        {
+            auto const plies = available_plies(board);
+            auto const maximise = board.turn == Colour::white;
+            auto best = plies[0];
+            auto best_score = minimax(board, best, depth);
+
+            for (auto ply : plies)
+            {
+                auto const score = minimax(board, ply, depth);
+                if (maximise ? score > best_score : score < best_score)
+                {
+                    best = ply;
+                    best_score = score;
+                }
+            }
+
+            return best;
+        }
+    }
+
     TEST(suggester_test, board_with_one_move_suggests_that_move)
     {
         auto board = Board::with_pieces({
@@ -22,7 +82,145 @@ namespace chess
         auto board = Board::standard();
         auto suggester = Suggester{board, evaluate_with_summation};
         auto move = suggester.suggest();
+        EXPECT_NE(MoveType::invalid, move.type);
+    }
+
+    TEST(suggester_test, no_moves_suggests_invalid_move)
+    {
+        auto board = text::from_fen("7k/6Q1/6K1/8/8/8/8/8 b - - 0 1");
+        auto suggester = Suggester{board, evaluate_with_summation};
+        EXPECT_EQ(MoveType::invalid, suggester.suggest().type);
+    }
+
+    TEST(suggester_test, finds_mate_in_one)
+    {
+        auto board = text::from_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+        auto suggester = Suggester{board, evaluate_with_summation, 2};
+        auto move = suggester.suggest();
+        EXPECT_EQ(Loc{"A8"}, move.dest);
+        EXPECT_EQ(MoveType::checkmate, move.type);
+    }
+
+    TEST(suggester_test, alpha_beta_picks_the_minimax_move)
+    {
+        auto const fens = {
+                text::standard_fen,
+                "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+                "4k3/8/8/3q4/8/2N5/8/4K3 b - - 0 1",
+        };
+
+        for (auto fen : fens)
+        {
+            auto const board = text::from_fen(fen);
+            for (int depth = 1; depth <= 3; ++depth)
+            {
+                auto const suggested = Suggester{board, evaluate_with_summation, depth}.suggest();
+                auto const expected = minimax_best(board, depth);
+                EXPECT_EQ(expected.src(), suggested.src) << fen << " at depth " << depth;
+                EXPECT_EQ(expected.dest(), suggested.dest) << fen << " at depth " << depth;
+            }
+        }
+    }
+
+    TEST(suggester_test, depth_limit_searches_every_depth_up_to_it)
+    {
+        auto const board = Board::standard();
+        auto const result = Suggester{board, evaluate_with_summation, SearchLimits{3}}.search();
+
+        EXPECT_EQ(3, result.depth);
+        EXPECT_GT(result.nodes, 0u);
+        EXPECT_EQ(minimax_best(board, 3).dest(), result.move.dest);
+    }
+
+    TEST(suggester_test, node_limit_keeps_the_deepest_finished_iteration)
+    {
+        auto limits = SearchLimits{};
+        limits.depth = 10;
+        limits.nodes = 500;
+
+        auto const board = Board::standard();
+        auto const result = Suggester{board, evaluate_with_summation, limits}.search();
+
+        // Depths 1 and 2 fit in the budget, depth 3 does not.
+        EXPECT_EQ(2, result.depth);
+        EXPECT_LE(result.nodes, 500u);
+        EXPECT_EQ(minimax_best(board, 2).dest(), result.move.dest);
+    }
+
+    TEST(suggester_test, first_iteration_finishes_whatever_the_budget)
+    {
+        auto limits = SearchLimits{};
+        limits.depth = 10;
+        limits.nodes = 0;
+        limits.time = std::chrono::milliseconds{0};
+
+        auto const result = Suggester{Board::standard(), evaluate_with_summation, limits}.search();
+
+        EXPECT_EQ(1, result.depth);
+        EXPECT_NE(MoveType::invalid, result.move.type);
+    }
+
+    TEST(suggester_test, time_limit_stops_a_deep_search)
+    {
+        auto limits = SearchLimits{};
+        limits.depth = 50;
+        limits.time = std::chrono::milliseconds{50};
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = Suggester{Board::standard(), evaluate_with_summation, limits}.search();
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_GE(result.depth, 1);
+        EXPECT_LT(result.depth, 50);
+        EXPECT_LT(elapsed, std::chrono::seconds{5});
     }
 
-    // TODO: Test checkmate/stalemate
-}
\ No newline at end of file
+    TEST(suggester_test, transposition_table_keeps_the_move_and_saves_nodes)
+    {
+        auto const fens = {
+                text::standard_fen,
+                "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+        };
+
+        for (auto fen : fens)
+        {
+            auto const board = text::from_fen(fen);
+
+            // Two plies are too few to transpose, so at depth 3 the table can only match the search without it.
+            for (int depth = 3; depth <= 5; ++depth)
+            {
+                auto table = TranspositionTable{1024 * 1024};
+
+                auto const without = Suggester{board, evaluate_with_summation, SearchLimits{depth}}.search();
+                auto const with = Suggester{board, evaluate_with_summation, SearchLimits{depth}, table}.search();
+
+                EXPECT_EQ(without.move.src, with.move.src) << fen << " at depth " << depth;
+                EXPECT_EQ(without.move.dest, with.move.dest) << fen << " at depth " << depth;
+                if (depth == 3)
+                {
+                    EXPECT_LE(with.nodes, without.nodes) << fen << " at depth " << depth;
+                }
+                else
+                {
+                    EXPECT_LT(with.nodes, without.nodes) << fen << " at depth " << depth;
+                }
+            }
+        }
+    }
+
+    TEST(suggester_test, transposition_table_can_be_reused_between_searches)
+    {
+        auto table = TranspositionTable{1024 * 1024};
+        auto const board = text::from_fen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+
+        for (int i = 0; i < 2; ++i)
+        {
+            auto const move = Suggester{board, evaluate_with_summation, SearchLimits{3}, table}.suggest();
+            EXPECT_EQ(Loc{"A8"}, move.dest);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#include <chess/TranspositionTable.h>
+#include <perf/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+namespace chess
+{
+    namespace
+    {
+        // Keys in one bucket of any table with at most this many buckets.
+        constexpr ZobristKey same_bucket(int n)
+        {
+            return ZobristKey{0x1000000ull} * (n + 1);
+        }
+    }
+
+    TEST(transposition_table_test, size_is_a_power_of_two_buckets)
+    {
+        EXPECT_EQ(1u, TranspositionTable{0}.bucket_count());
+        EXPECT_EQ(1u, TranspositionTable{64}.bucket_count());
+        EXPECT_EQ(2u, TranspositionTable{64 * 3}.bucket_count());
+        EXPECT_EQ(16384u, TranspositionTable{1024 * 1024}.bucket_count());
+    }
+
+    TEST(transposition_table_test, stored_entry_is_found_again)
+    {
+        auto table = TranspositionTable{1024};
+        auto const ply = Ply{"E7", "E8", PlyKind::promotion, SquareType::knight};
+
+        EXPECT_FALSE(table.probe(42));
+        table.store(42, TableEntry{-1234, 5, Bound::lower, ply});
+
+        auto const entry = table.probe(42);
+        ASSERT_TRUE(entry);
+        EXPECT_EQ(-1234, entry->score);
+        EXPECT_EQ(5, entry->depth);
+        EXPECT_EQ(Bound::lower, entry->bound);
+        EXPECT_EQ(ply, entry->ply);
+
+        EXPECT_FALSE(table.probe(43));
+    }
+
+    TEST(transposition_table_test, entry_without_a_ply)
+    {
+        auto table = TranspositionTable{1024};
+        table.store(7, TableEntry{0, 0, Bound::exact});
+
+        auto const entry = table.probe(7);
+        ASSERT_TRUE(entry);
+        EXPECT_FALSE(entry->ply);
+    }
+
+    TEST(transposition_table_test, same_position_is_overwritten)
+    {
+        auto table = TranspositionTable{64};
+        table.store(same_bucket(0), TableEntry{1, 6, Bound::exact});
+        table.store(same_bucket(0), TableEntry{2, 2, Bound::upper});
+
+        EXPECT_EQ(2, table.probe(same_bucket(0))->score);
+    }
+
+    TEST(transposition_table_test, full_bucket_replaces_the_shallowest_entry)
+    {
+        auto table = TranspositionTable{64};
+        for (int i = 0; i < static_cast<int>(TranspositionTable::entries_per_bucket); ++i)
+        {
+            table.store(same_bucket(i), TableEntry{i, i == 2 ? 1 : 8, Bound::exact});
+        }
+
+        table.store(same_bucket(10), TableEntry{10, 3, Bound::exact});
+
+        EXPECT_TRUE(table.probe(same_bucket(0)));
+        EXPECT_TRUE(table.probe(same_bucket(1)));
+        EXPECT_FALSE(table.probe(same_bucket(2)));
+        EXPECT_TRUE(table.probe(same_bucket(3)));
+        EXPECT_TRUE(table.probe(same_bucket(10)));
+    }
+
+    TEST(transposition_table_test, clear_forgets_everything)
+    {
+        auto table = TranspositionTable{1024};
+        table.store(42, TableEntry{1, 1, Bound::exact});
+        table.clear();
+        EXPECT_FALSE(table.probe(42));
+    }
+
+    TEST(transposition_table_test, threads_sharing_a_table_never_see_another_positions_entry)
+    {
+        // A table of one bucket, so every thread's writes race with every other's.
+        auto table = TranspositionTable{64};
+        auto pool = perf::ThreadPool{4};
+        auto const key_of = [](std::size_t n) { return ZobristKey{0x9e3779b97f4a7c15ull} * (n % 16 + 1); };
+        auto const score_of = [](ZobristKey key) { return static_cast<int>(key >> 40); };
+        auto wrong = std::atomic<int>{0};
+
+        pool.for_each_chunk(200000, [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                auto const key = key_of(i);
+                table.store(key, TableEntry{score_of(key), static_cast<int>(i % 20), Bound::exact});
+
+                auto const other = key_of(i + 5);
+                if (auto const entry = table.probe(other); entry && entry->score != score_of(other))
+                {
+                    ++wrong;
+                }
+            }
+        });
+
+        EXPECT_EQ(0, wrong);
+    }
+}
@@ -0,0 +1,183 @@
+#include <chess/text/fen.h>
+
+#include <cctype>
+#include <optional>
+#include <sstream>
+#include <string>
+
+namespace text = chess::text;
+using chess::Board;
+using chess::Colour;
+using chess::Loc;
+using chess::Square;
+using chess::SquareType;
+using chess::text::FenError;
+
+namespace
+{
+    std::optional<SquareType> type_of(char symbol)
+    {
+        switch (std::tolower(static_cast<unsigned char>(symbol)))
+        {
+            case 'p':
+                return SquareType::pawn;
+            case 'r':
+                return SquareType::rook;
+            case 'n':
+                return SquareType::knight;
+            case 'b':
+                return SquareType::bishop;
+            case 'q':
+                return SquareType::queen;
+            case 'k':
+                return SquareType::king;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    /**
+     * Pieces are placed as moved. Only a pawn on its starting rank is left unmoved, so it can still double jump.
+     */
+    void place_pieces(Board & board, std::string const& placement)
+    {
+        int x = 0;
+        int y = Loc::side_size - 1;
+
+        for (auto c : placement)
+        {
+            if (c == '/')
+            {
+                if (x != Loc::side_size || y == 0)
+                {
+                    throw FenError{"Bad rank in FEN piece placement: " + placement};
+                }
+                x = 0;
+                --y;
+            }
+            else if (c >= '1' && c <= '8')
+            {
+                x += c - '0';
+            }
+            else if (auto type = type_of(c))
+            {
+                if (x >= Loc::side_size)
+                {
+                    throw FenError{"Too many squares in FEN rank: " + placement};
+                }
+
+                auto const colour = std::isupper(static_cast<unsigned char>(c)) ? Colour::white : Colour::black;
+                auto const pawn_start_y = colour == Colour::white ? 1 : Loc::side_size - 2;
+                auto const moved = *type != SquareType::pawn || y != pawn_start_y;
+
+                board[Loc{x, y}] = Square{*type, colour, moved};
+                ++x;
+            }
+            else
+            {
+                throw FenError{std::string{"Unexpected character in FEN piece placement: "} + c};
+            }
+
+            if (x > Loc::side_size)
+            {
+                throw FenError{"Too many squares in FEN rank: " + placement};
+            }
+        }
+
+        if (x != Loc::side_size || y != 0)
+        {
+            throw FenError{"FEN piece placement does not cover the board: " + placement};
+        }
+    }
+
+    /**
+     * Clear the moved flag on a king or rook that a castling right needs.
+     */
+    void unmove(Board & board, Loc loc, Square expected)
+    {
+        auto const sq = static_cast<Square>(board[loc]);
+        if (sq != expected)
+        {
+            throw FenError{"FEN castling rights do not match the pieces on the board"};
+        }
+        board[loc] = Square{sq.type(), sq.colour()};
+    }
+
+    void apply_castling(Board & board, std::string const& castling)
+    {
+        if (castling == "-")
+        {
+            return;
+        }
+
+        for (auto c : castling)
+        {
+            auto const colour = std::isupper(static_cast<unsigned char>(c)) ? Colour::white : Colour::black;
+            auto const y = colour == Colour::white ? 0 : Loc::side_size - 1;
+
+            switch (std::tolower(static_cast<unsigned char>(c)))
+            {
+                case 'k':
+                    unmove(board, Loc{4, y}, chess::King(colour));
+                    unmove(board, Loc{Loc::side_size - 1, y}, chess::Rook(colour));
+                    break;
+                case 'q':
+                    unmove(board, Loc{4, y}, chess::King(colour));
+                    unmove(board, Loc{0, y}, chess::Rook(colour));
+                    break;
+                default:
+                    throw FenError{"Unexpected character in FEN castling rights: " + castling};
+            }
+        }
+    }
+
+    void apply_en_passant(Board & board, std::string const& target)
+    {
+        if (target == "-")
+        {
+            return;
+        }
+
+        if (target.size() != 2 || target[0] < 'a' || target[0] > 'h' || (target[1] != '3' && target[1] != '6'))
+        {
+            throw FenError{"Bad FEN en passant square: " + target};
+        }
+
+        // The target is the square jumped over, the board wants the square the pawn landed on.
+        auto const x = target[0] - 'a';
+        auto const y = target[1] == '3' ? 3 : 4;
+        board.last_turn_pawn_double_jump_dest = Loc{x, y};
+    }
+}
+
+Board text::from_fen(std::string_view fen)
+{
+    auto stream = std::istringstream{std::string{fen}};
+    std::string placement, turn, castling, en_passant;
+
+    if (!(stream >> placement >> turn >> castling >> en_passant))
+    {
+        throw FenError{"FEN needs piece placement, turn, castling rights and en passant fields"};
+    }
+
+    auto board = Board::blank();
+    place_pieces(board, placement);
+
+    if (turn == "w")
+    {
+        board.turn = Colour::white;
+    }
+    else if (turn == "b")
+    {
+        board.turn = Colour::black;
+    }
+    else
+    {
+        throw FenError{"Bad FEN turn: " + turn};
+    }
+
+    apply_castling(board, castling);
+    apply_en_passant(board, en_passant);
+
+    return board;
+}
@@ -100,4 +100,22 @@ void text::print(std::ostream & os, Board const& board)
     }
 
     os << '\n' << top_row << "\n";
-}
\ No newline at end of file
+}
+
+std::string text::to_string(Ply ply)
+{
+    auto text = std::string{};
+
+    for (auto loc : {ply.src(), ply.dest()})
+    {
+        text += static_cast<char>('a' + loc.x());
+        text += static_cast<char>('1' + loc.y());
+    }
+
+    if (ply.kind() == PlyKind::promotion)
+    {
+        text += base_symbol(Square{ply.promotion(), Colour::black});
+    }
+
+    return text;
+}
@@ -0,0 +1,168 @@
+#include <perf/ThreadPool.h>
+
+#include <algorithm>
+
+using perf::ThreadPool;
+
+namespace
+{
+    // Several chunks per thread so a thread that draws slow jobs does not hold everyone else up.
+    constexpr std::size_t chunks_per_thread = 8;
+
+    // The pool this thread is running chunks for, if any, and its thread index there.
+    thread_local ThreadPool const * current_pool = nullptr;
+    thread_local std::size_t current_thread = 0;
+
+    class RunningOn
+    {
+    public:
+        RunningOn(ThreadPool const& pool, std::size_t thread) :
+                m_previous_pool{current_pool},
+                m_previous_thread{current_thread}
+        {
+            current_pool = &pool;
+            current_thread = thread;
+        }
+
+        ~RunningOn()
+        {
+            current_pool = m_previous_pool;
+            current_thread = m_previous_thread;
+        }
+
+        RunningOn(RunningOn const&) = delete;
+        RunningOn & operator=(RunningOn const&) = delete;
+
+    private:
+        ThreadPool const * m_previous_pool;
+        std::size_t m_previous_thread;
+    };
+}
+
+ThreadPool::ThreadPool(std::size_t threads)
+{
+    auto const workers = std::max<std::size_t>(threads, 1) - 1;
+    m_workers.reserve(workers);
+
+    for (std::size_t i = 0; i < workers; ++i)
+    {
+        // The calling thread is thread 0.
+        m_workers.emplace_back([this, i] { work(i + 1); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (auto & worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const
+{
+    return m_workers.size() + 1;
+}
+
+std::size_t ThreadPool::default_threads()
+{
+    // Allowed to be zero when it cannot be worked out.
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void ThreadPool::for_each_chunk(std::size_t count,
+                                std::function<void(std::size_t, std::size_t, std::size_t)> const& job)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (current_pool == this)
+    {
+        // Called from inside one of our own jobs. Every other thread may be waiting on this one, so waiting for them
+        // in turn would never finish.
+        job(0, count, current_thread);
+        return;
+    }
+
+    auto run_lock = std::lock_guard{m_run_mutex};
+    auto running = RunningOn{*this, 0};
+
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_job = &job;
+        m_count = count;
+        m_chunk_size = std::max<std::size_t>(count / (size() * chunks_per_thread), 1);
+        m_next = 0;
+        m_busy = m_workers.size();
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    run_chunks(0);
+
+    auto lock = std::unique_lock{m_mutex};
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_job = nullptr;
+
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void ThreadPool::work(std::size_t thread)
+{
+    auto running = RunningOn{*this, thread};
+    auto seen = std::size_t{0};
+
+    while (true)
+    {
+        {
+            auto lock = std::unique_lock{m_mutex};
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+            if (m_stopping)
+            {
+                return;
+            }
+            seen = m_generation;
+        }
+
+        run_chunks(thread);
+
+        auto lock = std::lock_guard{m_mutex};
+        if (--m_busy == 0)
+        {
+            m_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run_chunks(std::size_t thread)
+{
+    try
+    {
+        for (auto begin = m_next.fetch_add(m_chunk_size); begin < m_count; begin = m_next.fetch_add(m_chunk_size))
+        {
+            (*m_job)(begin, std::min(begin + m_chunk_size, m_count), thread);
+        }
+    }
+    catch (...)
+    {
+        auto lock = std::lock_guard{m_mutex};
+        if (!m_error)
+        {
+            m_error = std::current_exception();
+        }
+        // Nobody claims anything past the end.
+        m_next = m_count;
+    }
+}
@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <numeric>
+
 namespace perf
 {
     TEST(StackVector_test, new_vector_has_zero_size)
@@ -56,4 +59,44 @@ namespace perf
         v.push_back(1);
         EXPECT_THROW(v.push_back(2), std::logic_error);
     }
+
+    TEST(StackVector_test, const_access_reads_elements)
+    {
+        auto v = StackVector<int, 10>{};
+        v.push_back(1);
+        v.push_back(2);
+
+        auto const& cv = v;
+        EXPECT_EQ(2, cv[1]);
+        EXPECT_EQ(3, std::accumulate(cv.begin(), cv.end(), 0));
+    }
+
+    TEST(StackVector_test, clear_empties_the_vector)
+    {
+        auto v = StackVector<int, 2>{};
+        EXPECT_TRUE(v.empty());
+        v.push_back(1);
+        v.push_back(2);
+        EXPECT_FALSE(v.empty());
+
+        v.clear();
+        EXPECT_TRUE(v.empty());
+        v.push_back(3);
+        EXPECT_EQ(3, v[0]);
+    }
+
+    TEST(StackVector_test, erase_with_remove_if_drops_matching_elements)
+    {
+        auto v = StackVector<int, 10>{};
+        for (int i = 0; i < 6; ++i)
+        {
+            v.push_back(i);
+        }
+
+        v.erase(std::remove_if(v.begin(), v.end(), [](int e) { return e % 2 == 0; }), v.end());
+
+        std::vector<int> actual(v.begin(), v.end());
+        std::vector<int> expected{1, 3, 5};
+        EXPECT_EQ(expected, actual);
+    }
 }
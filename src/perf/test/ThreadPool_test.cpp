@@ -0,0 +1,121 @@
+#include <perf/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace perf
+{
+    TEST(ThreadPool_test, pool_counts_the_calling_thread)
+    {
+        EXPECT_EQ(1, ThreadPool{1}.size());
+        EXPECT_EQ(4, ThreadPool{4}.size());
+        EXPECT_EQ(1, ThreadPool{0}.size());
+    }
+
+    TEST(ThreadPool_test, every_index_is_visited_once)
+    {
+        auto pool = ThreadPool{4};
+        auto visits = std::vector<int>(10000);
+
+        pool.for_each_chunk(visits.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                ++visits[i];
+            }
+        });
+
+        for (auto v : visits)
+        {
+            EXPECT_EQ(1, v);
+        }
+    }
+
+    TEST(ThreadPool_test, thread_index_is_in_range)
+    {
+        auto pool = ThreadPool{3};
+        auto threads = std::vector<std::size_t>(1000);
+
+        pool.for_each_chunk(threads.size(), [&](std::size_t begin, std::size_t end, std::size_t thread)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                threads[i] = thread;
+            }
+        });
+
+        for (auto thread : threads)
+        {
+            EXPECT_LT(thread, pool.size());
+        }
+    }
+
+    TEST(ThreadPool_test, nested_call_runs_inline)
+    {
+        auto pool = ThreadPool{4};
+        auto visits = std::vector<std::atomic<int>>(100 * 50);
+
+        pool.for_each_chunk(100, [&](std::size_t outer_begin, std::size_t outer_end, std::size_t outer_thread)
+        {
+            for (auto outer = outer_begin; outer < outer_end; ++outer)
+            {
+                pool.for_each_chunk(50, [&](std::size_t begin, std::size_t end, std::size_t thread)
+                {
+                    EXPECT_EQ(outer_thread, thread);
+                    for (auto i = begin; i < end; ++i)
+                    {
+                        ++visits[outer * 50 + i];
+                    }
+                });
+            }
+        });
+
+        for (auto const& v : visits)
+        {
+            EXPECT_EQ(1, v);
+        }
+    }
+
+    TEST(ThreadPool_test, pool_can_be_reused)
+    {
+        auto pool = ThreadPool{4};
+
+        for (int round = 0; round < 50; ++round)
+        {
+            auto visits = std::vector<int>(round * 7);
+            pool.for_each_chunk(visits.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+            {
+                for (auto i = begin; i < end; ++i)
+                {
+                    ++visits[i];
+                }
+            });
+
+            for (auto v : visits)
+            {
+                EXPECT_EQ(1, v);
+            }
+        }
+    }
+
+    TEST(ThreadPool_test, job_exception_is_rethrown)
+    {
+        auto pool = ThreadPool{4};
+
+        EXPECT_THROW(pool.for_each_chunk(100, [](std::size_t begin, std::size_t end, std::size_t)
+        {
+            if (begin <= 50 && 50 < end)
+            {
+                throw std::runtime_error{"bad job"};
+            }
+        }), std::runtime_error);
+
+        // Still usable afterwards.
+        auto count = 0;
+        pool.for_each_chunk(1, [&](std::size_t, std::size_t, std::size_t) { ++count; });
+        EXPECT_EQ(1, count);
+    }
+}